@@ -0,0 +1,154 @@
+/*
+ * EvalBench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <functional>
+#include "Connect4.h"
+
+using namespace std;
+using namespace std::chrono;
+
+/* positions from random legal games, stopped before anyone has four in a row */
+static vector<state> random_positions(size_t count, uint64_t seed){
+	mt19937_64 random(seed);
+	vector<state> positions;
+	positions.reserve(count);
+	while(positions.size() < count){
+		state s(0,false,0,0);
+		size_t plies = random() % geometry::CELLS;
+		for(size_t ply = 0; ply < plies; ply++){
+			int cell = geometry::drop(s.players[0] | s.players[1], random() % geometry::WIDTH);
+			if(cell < 0){
+				continue;
+			}
+			state next(s);
+			next.place(s.turn, cell);
+			if(next.fours[s.turn]){
+				break;
+			}
+			next.turn = !s.turn;
+			s = next;
+		}
+		positions.push_back(s);
+	}
+	return positions;
+}
+
+/*
+ * The whole board kernels of Board against a window at a time over random games on Board, in nanoseconds per
+ * position. Returns the positions they disagree on.
+ */
+template<typename Board>
+static size_t geometry_bench(size_t count, size_t rounds){
+	static constexpr typename Board::window_table windows;
+	mt19937_64 random(1473376696515541738ull);
+	vector<pair<uint64_t, uint64_t>> positions; // first's and second's discs
+	while(positions.size() < count){
+		uint64_t discs[2] = {0, 0};
+		size_t plies = random() % Board::CELLS;
+		for(size_t ply = 0; ply < plies; ply++){
+			int cell = Board::drop(discs[0] | discs[1], random() % Board::WIDTH);
+			if(cell < 0){
+				continue;
+			}
+			uint64_t next = discs[ply % 2] | uint64_t(1) << cell;
+			if(Board::lines(next)){
+				break;
+			}
+			discs[ply % 2] = next;
+		}
+		positions.emplace_back(discs[0], discs[1]);
+	}
+	size_t mismatches = 0;
+	for(auto &p : positions){
+		int expected = 0;
+		for(uint64_t window : windows.all){
+			int mine = Board::ones(p.first & window), theirs = Board::ones(p.second & window);
+			expected += (mine == 0 ? -theirs*theirs : 0) + (theirs == 0 ? mine*mine : 0);
+		}
+		uint64_t won = 0, lost = 0;
+		mismatches += Board::score(p.first, p.second, won, lost) != expected || won || lost;
+	}
+	steady_clock::time_point begin = steady_clock::now();
+	long long checksum = 0;
+	for(size_t round = 0; round < rounds; round++){
+		for(auto &p : positions){
+			uint64_t won = 0, lost = 0;
+			checksum += Board::score(p.first, p.second, won, lost) + (won | lost);
+		}
+	}
+	double ns = duration<double, nano>(steady_clock::now() - begin).count() / (rounds * positions.size());
+	cout << Board::WIDTH << 'x' << Board::HEIGHT << " score " << fixed << setprecision(2) << ns << " ns/position, "
+		<< Board::WINDOWS << " windows, mismatches " << mismatches << " (checksum " << checksum << ")" << endl;
+	return mismatches;
+}
+
+template<typename... Boards>
+static size_t geometry_bench(board_list<Boards...>, size_t count, size_t rounds){
+	return (geometry_bench<Boards>(count, rounds) + ...);
+}
+
+template<typename Eval>
+static double time_eval(const vector<state>& positions, size_t rounds, Eval eval, long long &checksum){
+	steady_clock::time_point begin = steady_clock::now();
+	long long sum = 0;
+	for(size_t round = 0; round < rounds; round++){
+		for(const state& s : positions){
+			sum += eval(s);
+		}
+	}
+	checksum = sum;
+	return duration<double, nano>(steady_clock::now() - begin).count() / (rounds * positions.size());
+}
+
+/**
+ * Nanoseconds per position of every evaluator over the same random positions, and whether they agree, then the
+ * board kernels checked and timed on their own on every board the bot plays.
+ * usage: EvalBench [positions] [rounds]
+ */
+int main(int argc, char* argv[]){
+	size_t count = argc > 1 ? stoul(argv[1]) : 100000;
+	size_t rounds = argc > 2 ? stoul(argv[2]) : 20;
+	vector<state> positions = random_positions(count, 1473376696515541738ull);
+	vector<score> batch(positions.size());
+	heuristic()(positions.data(), batch.data(), positions.size());
+	size_t mismatches = 0;
+	for(size_t i = 0; i < positions.size(); ++i){
+		const state& s = positions[i];
+		int expected = scan_board(s);
+		mismatches += shift_board(s) != expected || evaluate(s) != expected || batch[i] != expected;
+		mismatches += shift_winner(s.players[0]) != (s.fours[0] > 0) || shift_winner(s.players[1]) != (s.fours[1] > 0);
+	}
+	cout << "positions " << count << " mismatches " << mismatches << endl;
+	const vector<pair<string, function<int(const state&)>>> evaluators = {
+		{"scan_board", scan_board},
+		{"shift_board", shift_board},
+		{"evaluate", evaluate<geometry>},
+		{"shift_winner", [](const state& s){ return int(shift_winner(s.players[0]) | shift_winner(s.players[1]) << 1); }}
+	};
+	for(auto &evaluator : evaluators){
+		long long checksum;
+		double ns = time_eval(positions, rounds, evaluator.second, checksum);
+		cout << left << setw(14) << evaluator.first << fixed << setprecision(2) << ns << " ns/position (checksum " << checksum << ")" << endl;
+	}
+	{ // the heuristic's batch call, as the tree makes it for the leaves below a node
+		steady_clock::time_point begin = steady_clock::now();
+		long long checksum = 0;
+		for(size_t round = 0; round < rounds; round++){
+			heuristic()(positions.data(), batch.data(), positions.size());
+			for(score value : batch){
+				checksum += value;
+			}
+		}
+		double ns = duration<double, nano>(steady_clock::now() - begin).count() / (rounds * positions.size());
+		cout << left << setw(14) << "batch" << fixed << setprecision(2) << ns << " ns/position (checksum " << checksum << ")" << endl;
+	}
+	mismatches += geometry_bench(boards(), count, rounds);
+	return mismatches != 0;
+}
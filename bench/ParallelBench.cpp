@@ -0,0 +1,54 @@
+/*
+ * ParallelBench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include "Connect4.h"
+
+using namespace std;
+using namespace dhlib::minimax;
+using namespace std::chrono;
+
+/**
+ * Time to depth, nodes per second and how often the first move searched caused the cutoff for the
+ * Lazy SMP search as the thread count doubles.
+ * usage: ParallelBench [max depth] [max threads]
+ */
+int main(int argc, char* argv[]){
+	size_t maxDepth = argc > 1 ? stoul(argv[1]) : 10;
+	unsigned maxThreads = argc > 2 ? stoul(argv[2]) : max(thread::hardware_concurrency(), 1u);
+	const vector<vector<choice>> positions = {
+		{},
+		{3, 3, 2, 4},
+		{3, 2, 3, 3, 4, 4, 2, 5}
+	};
+	cout << "position threads depth ms nodes knps first_cutoff choice score" << endl;
+	for(size_t p = 0; p < positions.size(); ++p){
+		for(unsigned threads = 1; threads <= maxThreads; threads *= 2){
+			minimax<score,state,choice,heuristic,get_choices> mm(state(0,false,0,0),MAX);
+			for(choice c : positions[p]){
+				mm.progress(c);
+			}
+			mm.threads(threads);
+			size_t nodes = 0;
+			steady_clock::duration elapsed(0);
+			for(size_t depth = 1; depth <= maxDepth; ++depth){
+				steady_clock::time_point begin = steady_clock::now();
+				mm.compute(depth);
+				elapsed += steady_clock::now() - begin;
+				nodes += mm.nodes();
+				double ms = duration<double, milli>(elapsed).count();
+				cout << p << ' ' << threads << ' ' << depth << ' '
+					<< fixed << setprecision(1) << ms << ' ' << nodes << ' '
+					<< setprecision(0) << (ms > 0 ? nodes / ms : 0) << ' '
+					<< setprecision(3) << mm.cutoffs().first_rate() << ' '
+					<< mm.choose(-1) << ' ' << mm.score() << endl;
+			}
+		}
+	}
+}
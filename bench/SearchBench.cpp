@@ -0,0 +1,56 @@
+/*
+ * SearchBench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "Connect4.h"
+
+using namespace std;
+using namespace dhlib::minimax;
+using namespace std::chrono;
+
+/**
+ * Nodes, re-searches and time to depth of every table search algorithm on the same positions, single threaded.
+ * Scores must agree between algorithms at every depth.
+ * usage: SearchBench [max depth]
+ */
+int main(int argc, char* argv[]){
+	size_t maxDepth = argc > 1 ? stoul(argv[1]) : 10;
+	const vector<vector<choice>> positions = {
+		{},
+		{3, 3, 2, 4},
+		{3, 2, 3, 3, 4, 4, 2, 5}
+	};
+	const vector<pair<const char*, search_algorithm>> algorithms = {
+		{"alphabeta", search_algorithm::alphabeta},
+		{"pvs", search_algorithm::pvs},
+		{"mtdf", search_algorithm::mtdf}
+	};
+	get_choices::randomize = false; // every algorithm sees the same move order
+	cout << "position algorithm depth ms nodes researches choice score" << endl;
+	for(size_t p = 0; p < positions.size(); ++p){
+		for(auto &algorithm : algorithms){
+			minimax<score,state,choice,heuristic,get_choices> mm(state(0,false,0,0),MAX);
+			for(choice c : positions[p]){
+				mm.progress(c);
+			}
+			mm.algorithm(algorithm.second);
+			size_t nodes = 0, researches = 0;
+			steady_clock::duration elapsed(0);
+			for(size_t depth = 1; depth <= maxDepth; ++depth){
+				steady_clock::time_point begin = steady_clock::now();
+				mm.compute(depth);
+				elapsed += steady_clock::now() - begin;
+				nodes += mm.nodes();
+				researches += mm.researches();
+				cout << p << ' ' << algorithm.first << ' ' << depth << ' '
+					<< fixed << setprecision(1) << duration<double, milli>(elapsed).count() << ' '
+					<< nodes << ' ' << researches << ' ' << mm.choose(-1) << ' ' << mm.score() << endl;
+			}
+		}
+	}
+}
@@ -0,0 +1,162 @@
+/*
+ * SearchSuite.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "Connect4.h"
+
+using namespace std;
+using namespace dhlib::minimax;
+using namespace std::chrono;
+
+static atomic<size_t> expansions(0), evaluations(0);
+
+/* the game's heuristic and choices, counting how often the search calls them */
+struct counted_heuristic {
+	score operator()(const state& s) const noexcept {
+		evaluations.fetch_add(1, memory_order_relaxed);
+		return heuristic()(s);
+	}
+	void operator()(const state* states, score* scores, size_t count) const noexcept {
+		evaluations.fetch_add(count, memory_order_relaxed);
+		heuristic()(states, scores, count);
+	}
+};
+template<bool Mirror> // plain runs keep mirrored boards apart to measure what sharing them saves
+struct counted_choices : get_choices {
+	static constexpr bool SYMMETRIC = Mirror;
+	void operator()(const state& s, buffer& children) noexcept {
+		expansions.fetch_add(1, memory_order_relaxed);
+		get_choices::operator()(s, children);
+	}
+};
+
+static size_t peak_kb(){
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+}
+
+static const vector<vector<choice>> positions = { // opening, early and middle game, one with a win on the board
+	{},
+	{3, 3, 2, 4},
+	{3, 2, 3, 3, 4, 4, 2, 5},
+	{3, 3, 3, 3, 2, 4, 4, 2, 5, 1},
+	{0, 6, 1, 5, 2, 4},
+	{3, 3, 3, 3, 3, 3, 2, 2, 2, 2, 2, 2, 4, 4}
+};
+
+template<typename Choices>
+static void run(size_t maxDepth, search_algorithm algorithm, unsigned threads, size_t seed, score aspiration){
+	for(size_t p = 0; p < positions.size(); ++p){
+		get_choices::seed(seed); // every position starts from the same engine state whatever ran before it
+		minimax<score,state,choice,counted_heuristic,Choices,collect_stats> mm(state(0,false,0,0),MAX);
+		for(choice c : positions[p]){
+			mm.progress(c);
+		}
+		mm.algorithm(algorithm);
+		mm.threads(threads);
+		mm.aspiration(aspiration);
+		cout << (p ? "," : "") << "\n  {\"moves\": [";
+		for(size_t m = 0; m < positions[p].size(); ++m){
+			cout << (m ? ", " : "") << positions[p][m];
+		}
+		cout << "], \"depths\": [";
+		steady_clock::duration total(0);
+		for(size_t depth = 1; depth <= maxDepth; ++depth){
+			expansions = 0;
+			evaluations = 0;
+			steady_clock::time_point begin = steady_clock::now();
+			mm.compute(depth);
+			steady_clock::duration elapsed = steady_clock::now() - begin;
+			total += elapsed;
+			double seconds = duration<double>(elapsed).count();
+			cout << (depth > 1 ? "," : "") << "\n    {\"depth\": " << depth
+				<< ", \"nodes_expanded\": " << expansions
+				<< ", \"heuristic_calls\": " << evaluations
+				<< ", \"nodes_per_sec\": " << fixed << setprecision(0) << (seconds > 0 ? expansions / seconds : 0)
+				<< ", \"wall_ms\": " << setprecision(3) << seconds * 1000
+				<< ", \"total_ms\": " << duration<double, milli>(total).count()
+				<< ", \"peak_rss_kb\": " << peak_kb()
+				<< ", \"tree_nodes\": " << mm.pool.size()
+				<< ", \"transpositions\": " << mm.stats().transpositions
+				<< ", \"cutoffs\": " << mm.stats().cutoffs
+				<< ", \"fail_lows\": " << mm.stats().fail_lows
+				<< ", \"fail_highs\": " << mm.stats().fail_highs
+				<< ", \"branching\": " << mm.stats().branching()
+				<< ", \"choice\": " << mm.choose(-1)
+				<< ", \"score\": " << mm.score() << "}";
+		}
+		cout << "\n  ]";
+		const choice best = mm.choose(-1);
+		if(best != -1){ // the search after a move, from the subtree and scores progress keeps
+			mm.progress(best);
+			expansions = 0;
+			steady_clock::time_point begin = steady_clock::now();
+			mm.compute(maxDepth);
+			cout << ", \"progressed\": {\"choice\": " << best << ", \"depth\": " << maxDepth
+				<< ", \"nodes_expanded\": " << expansions
+				<< ", \"wall_ms\": " << fixed << setprecision(3) << duration<double, milli>(steady_clock::now() - begin).count()
+				<< ", \"fail_lows\": " << mm.stats().fail_lows
+				<< ", \"fail_highs\": " << mm.stats().fail_highs
+				<< ", \"score\": " << mm.score() << "}";
+		}
+		cout << "}";
+	}
+}
+
+/**
+ * Runs compute(depth) for every depth up to max depth over a fixed set of positions with a fixed seed and writes one
+ * JSON object per run: per depth, the nodes expanded (calls to GetChoices), heuristic calls, expansions per second,
+ * wall time of the iteration and in total, the process's peak resident memory so far, the live tree nodes and
+ * the search_stats of the iteration, then the same of compute(max depth) after progress plays the best choice.
+ * plain keeps mirrored boards apart, a window above 0 turns on aspiration searches.
+ * usage: SearchSuite [max depth] [tree|alphabeta|pvs|mtdf] [threads] [seed] [mirror|plain] [aspiration window]
+ */
+int main(int argc, char* argv[]){
+	const size_t maxDepth = argc > 1 ? stoul(argv[1]) : 10;
+	const string name = argc > 2 ? argv[2] : "tree";
+	const unsigned threads = argc > 3 ? stoul(argv[3]) : 0;
+	const size_t seed = argc > 4 ? stoull(argv[4]) : 1473376696515541738ull;
+	const string symmetry = argc > 5 ? argv[5] : "mirror";
+	const score aspiration = argc > 6 ? stoi(argv[6]) : 0;
+	const vector<pair<string, search_algorithm>> algorithms = {
+		{"tree", search_algorithm::tree},
+		{"alphabeta", search_algorithm::alphabeta},
+		{"pvs", search_algorithm::pvs},
+		{"mtdf", search_algorithm::mtdf}
+	};
+	search_algorithm algorithm = search_algorithm::tree;
+	bool known = false;
+	for(auto &a : algorithms){
+		if(a.first == name){
+			algorithm = a.second;
+			known = true;
+		}
+	}
+	if(!known){
+		cerr << "unknown algorithm: " << name << endl;
+		return 1;
+	}
+	if(symmetry != "mirror" && symmetry != "plain"){
+		cerr << "unknown symmetry: " << symmetry << endl;
+		return 1;
+	}
+
+	cout << "{\"algorithm\": \"" << name << "\", \"threads\": " << threads << ", \"seed\": " << seed
+		<< ", \"max_depth\": " << maxDepth << ", \"mirror\": " << (symmetry == "mirror" ? "true" : "false")
+		<< ", \"aspiration\": " << aspiration << ", \"positions\": [";
+	if(symmetry == "mirror"){
+		run<counted_choices<true>>(maxDepth, algorithm, threads, seed, aspiration);
+	} else {
+		run<counted_choices<false>>(maxDepth, algorithm, threads, seed, aspiration);
+	}
+	cout << "\n]}" << endl;
+}
@@ -0,0 +1,119 @@
+/*
+ * TreeBench.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include "Connect4.h"
+#include "Compact.hpp"
+
+using namespace std;
+using namespace dhlib::minimax;
+using namespace std::chrono;
+
+using engine = minimax<score,state,choice,heuristic,get_choices,collect_stats>;
+using compact = compact_tree<score,state,choice,heuristic,get_choices>;
+
+namespace {
+	double per_second(size_t count, steady_clock::duration d){
+		return count / max(duration<double>(d).count(), 1e-9);
+	}
+
+	/* the bytes the pool's live nodes hold, get_choices has MAX_CHOICES so their children are kept in their slots */
+	size_t tree_bytes(const engine& mm){
+		return mm.pool.size() * (sizeof(engine::node) + alignof(engine::node)); // the slot's live flag pads to the alignment
+	}
+
+	/* visits every path below h reading each node's score, and its state too if states is set */
+	void walk(const engine& mm, handle h, bool states, size_t& visited, uint64_t& check){
+		const engine::node& n = mm.pool[h];
+		++visited;
+		check += n.score + (states ? n.state.players[0] ^ n.state.players[1] : 0);
+		for(handle child : n.children){
+			walk(mm, child, states, visited, check);
+		}
+	}
+
+	/* the paths below the root walked per second, reading scores, and reading states as well */
+	pair<double, double> walk_rates(const engine& mm, uint64_t& check){
+		double rates[2];
+		for(bool states : {false, true}){
+			size_t visited = 0;
+			steady_clock::time_point begin = steady_clock::now();
+			walk(mm, mm.root, states, visited, check);
+			rates[states] = per_second(visited, steady_clock::now() - begin);
+		}
+		return {rates[0], rates[1]};
+	}
+	pair<double, double> walk_rates(const compact& tree, uint64_t& check){
+		size_t visited = 0;
+		steady_clock::time_point begin = steady_clock::now();
+		tree.walk([&](compact::index n, size_t){
+			++visited;
+			check += tree.score(n);
+		});
+		double scores = per_second(visited, steady_clock::now() - begin);
+		visited = 0;
+		begin = steady_clock::now();
+		tree.replay([&](compact::index n, const state& s, size_t){
+			++visited;
+			check += tree.score(n) + (s.players[0] ^ s.players[1]);
+		});
+		return {scores, per_second(visited, steady_clock::now() - begin)};
+	}
+}
+
+
+/**
+ * Memory per node, search speed and traversal speed of the minimax tree search against compact_tree, iteratively
+ * deepened on both from the same positions. Walks visit every path from the root, reading the scores, then the
+ * states as well, which the minimax tree stores and compact_tree replays. Scores must agree at every depth.
+ * usage: TreeBench [max depth]
+ */
+int main(int argc, char* argv[]){
+	const size_t maxDepth = argc > 1 ? stoul(argv[1]) : 10;
+	const vector<vector<choice>> positions = {
+		{},
+		{3, 2, 3, 3, 4, 4, 2, 5}
+	};
+	get_choices::randomize = false; // both trees see the same moves
+	cout << "position depth tree nodes bytes/node search-ms search-nps walk-nps state-walk-nps score" << endl;
+	uint64_t check = 0;
+	for(size_t p = 0; p < positions.size(); ++p){
+		engine mm(state(0,false,0,0),MAX);
+		compact tree(state(0,false,0,0),MAX);
+		for(choice c : positions[p]){
+			mm.progress(c);
+			tree.progress(c);
+		}
+		for(size_t depth = 1; depth <= maxDepth; ++depth){
+			steady_clock::time_point begin = steady_clock::now();
+			mm.compute(depth);
+			steady_clock::duration searched = steady_clock::now() - begin;
+			pair<double, double> walked = walk_rates(mm, check);
+			cout << p << ' ' << depth << " minimax " << mm.pool.size() << ' '
+				<< fixed << setprecision(1) << double(tree_bytes(mm)) / mm.pool.size() << ' '
+				<< duration<double, milli>(searched).count() << ' ' << setprecision(0) << per_second(mm.stats().nodes(), searched) << ' '
+				<< walked.first << ' ' << walked.second << ' ' << mm.score() << endl;
+
+			begin = steady_clock::now();
+			tree.compute(depth);
+			searched = steady_clock::now() - begin;
+			walked = walk_rates(tree, check);
+			cout << p << ' ' << depth << " compact " << tree.size() << ' '
+				<< setprecision(1) << double(tree.bytes()) / tree.size() << ' '
+				<< duration<double, milli>(searched).count() << ' ' << setprecision(0) << per_second(tree.visited(), searched) << ' '
+				<< walked.first << ' ' << walked.second << ' ' << tree.score() << endl;
+			if(tree.score() != mm.score()){
+				cerr << "scores differ at position " << p << " depth " << depth << endl;
+				return 1;
+			}
+		}
+	}
+	if(check == 1){ // keeps the walks from being optimized away
+		cerr << endl;
+	}
+}
@@ -0,0 +1,247 @@
+/*
+ * Board.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef BOARD_H_
+#define BOARD_H_
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+
+/**
+ * The geometry of Connect N on a W wide and H high board, one 64 bit word of discs per player with the disc at row
+ * and col in bit row*W + col, row 0 at the bottom. Every mask, shift and loop bound is a compile time constant so
+ * move generation, win detection and evaluation unroll for each geometry. Lines are found with whole board shifts,
+ * a line in a direction is a start cell and the N-1 cells SHIFTS[d] apart above it, STARTS[d] holds the cells a
+ * line can start from so a shift that wraps into the next row never counts.
+ */
+template<int W, int H, int N>
+struct board {
+	static_assert(N > 1 && W >= N && H >= N, "a line must fit both across and up the board");
+	static_assert(W * H <= 64, "a player's discs are one 64 bit word");
+
+	static constexpr int WIDTH = W, HEIGHT = H, RUN = N, CELLS = W * H;
+	static constexpr int SHIFTS[4] = {1, W, W + 1, W - 1}; // ---, |, / and \.
+	static constexpr int BITS = N < 2 ? 1 : N < 4 ? 2 : N < 8 ? 3 : 4; // bit slices to count up to N discs
+	static constexpr int OPEN_BITS = N == 1 << (BITS - 1) ? BITS - 1 : BITS; // the slices a line short of N can set
+
+	/* the cells of rows [0, rows) and columns [firstCol, lastCol] */
+	static constexpr uint64_t cells(int rows, int firstCol, int lastCol) noexcept {
+		uint64_t starts = 0;
+		for(int row = 0; row < rows; row++){
+			for(int col = firstCol; col <= lastCol; col++){
+				starts |= uint64_t(1) << (row*W + col);
+			}
+		}
+		return starts;
+	}
+	static constexpr uint64_t FULL = cells(H, 0, W - 1);
+	static constexpr uint64_t BOTTOM = cells(1, 0, W - 1);
+	static constexpr uint64_t FIRST_COLUMN = cells(H, 0, 0);
+	static constexpr uint64_t STARTS[4] = {
+		cells(H, 0, W - N),
+		cells(H - N + 1, 0, W - 1),
+		cells(H - N + 1, 0, W - N),
+		cells(H - N + 1, N - 1, W - 1)
+	};
+
+	/* the line starting at bit 0 with its cells shift apart */
+	static constexpr uint64_t line(int shift) noexcept {
+		uint64_t l = 0;
+		for(int i = 0; i < N; i++){
+			l |= uint64_t(1) << i*shift;
+		}
+		return l;
+	}
+
+	static constexpr uint64_t column(int col) noexcept {
+		return FIRST_COLUMN << col;
+	}
+
+	/* the columns nearest the centre first, left before right */
+	static constexpr std::array<int, W> centre_first() noexcept {
+		std::array<int, W> order = {};
+		int n = 0;
+		for(int left = (W - 1) / 2, right = W / 2; left >= 0; --left, ++right){
+			order[n++] = left;
+			if(right != left){
+				order[n++] = right;
+			}
+		}
+		return order;
+	}
+	static constexpr std::array<int, W> CENTRE_FIRST = centre_first();
+
+	static constexpr int ones(uint64_t x) noexcept {
+		return __builtin_popcountll(x);
+	}
+
+	/* the cell a disc dropped in col lands in, -1 if the column is full */
+	static constexpr int drop(uint64_t occupied, int col) noexcept {
+		uint64_t open = column(col) & ~occupied;
+		return open ? __builtin_ctzll(open) : -1;
+	}
+
+	/* the lowest empty cell of every column that has one */
+	static constexpr uint64_t playable(uint64_t occupied) noexcept {
+		return (occupied << W | BOTTOM) & FULL & ~occupied;
+	}
+
+	/* the cells that would complete a line of discs, empty unless the other player holds them */
+	static constexpr uint64_t winning_cells(uint64_t discs) noexcept {
+		uint64_t cells = 0;
+		for(int d = 0; d < 4; d++){
+			for(int gap = d == 1 ? N - 1 : 0; gap < N; gap++){ // discs stack, only the top of a column can be missing
+				uint64_t starts = STARTS[d];
+				for(int i = 0; i < N; i++){
+					if(i != gap){
+						starts &= discs >> i*SHIFTS[d];
+					}
+				}
+				cells |= starts << gap*SHIFTS[d];
+			}
+		}
+		return cells & FULL & ~discs;
+	}
+
+	/* column c of every row moves to column W-1-c, each column is masked out and shifted across in one step */
+	static constexpr uint64_t mirror(uint64_t discs) noexcept {
+		uint64_t reflected = 0;
+		for(int col = 0; col < W; col++){
+			uint64_t c = discs & column(col);
+			int to = W - 1 - col;
+			reflected |= to > col ? c << (to - col) : c >> (col - to);
+		}
+		return reflected;
+	}
+
+	/* the start cell of every complete line of discs */
+	static constexpr uint64_t lines(uint64_t discs) noexcept {
+		uint64_t complete = 0;
+		for(int d = 0; d < 4; d++){
+			uint64_t run = discs;
+			for(int i = 1; i < N; i++){
+				run &= discs >> i*SHIFTS[d];
+			}
+			complete |= run & STARTS[d];
+		}
+		return complete;
+	}
+
+	/*
+	 * The disc count of every line in one direction at once, bit i of slices[k] is bit k of the count of the line
+	 * starting at cell i. The N cells are added as bit slices so no line is looked at on its own.
+	 */
+	struct counts {
+		uint64_t any; // lines holding a disc
+		uint64_t complete; // lines holding N
+		std::array<uint64_t, BITS> slices;
+
+		constexpr counts(uint64_t discs, int shift) noexcept : any(0), complete(~uint64_t(0)), slices() {
+			for(int i = 0; i < N; i++){
+				uint64_t carry = discs >> i*shift;
+				any |= carry;
+				for(int k = 0; k < BITS && 1 << k <= i + 1; k++){ // ripple add one bit to every count, up to the slices i+1 needs
+					uint64_t next = slices[k] & carry;
+					slices[k] ^= carry;
+					carry = next;
+				}
+			}
+			if(OPEN_BITS < BITS){ // only N itself sets the top slice
+				complete = slices[BITS - 1];
+			} else {
+				for(int k = 0; k < BITS; k++){
+					complete &= N >> k & 1 ? slices[k] : ~slices[k];
+				}
+			}
+		}
+
+		/* the sum of the squared counts of the lines in open, complete lines excluded */
+		constexpr int squares(uint64_t open) const noexcept {
+			open &= ~complete;
+			int sum = 0;
+			for(int j = 0; j < OPEN_BITS; j++){ // count^2 is the sum of 2^(j+k) over every pair of set bits j and k
+				for(int k = 0; k < OPEN_BITS; k++){
+					sum += ones(slices[j] & slices[k] & open) << (j + k);
+				}
+			}
+			return sum;
+		}
+	};
+
+	/* the squared disc counts of the lines only mine can complete, less those only theirs can, and who has a line */
+	static constexpr int score(uint64_t mine, uint64_t theirs, uint64_t& won, uint64_t& lost) noexcept {
+		int sum = 0;
+		for(int d = 0; d < 4; d++){
+			counts m(mine, SHIFTS[d]), t(theirs, SHIFTS[d]);
+			sum += m.squares(STARTS[d] & ~t.any);
+			sum -= t.squares(STARTS[d] & ~m.any);
+			won |= m.complete & STARTS[d];
+			lost |= t.complete & STARTS[d];
+		}
+		return sum;
+	}
+
+	static constexpr int WINDOWS = ones(STARTS[0]) + ones(STARTS[1]) + ones(STARTS[2]) + ones(STARTS[3]);
+	static constexpr int MAX_THROUGH = 4 * N; // a cell is in at most N lines of every direction
+
+	/* every line of the board, and for every cell the lines through it, so placing a disc rescores only those */
+	struct window_table {
+		std::array<uint64_t, WINDOWS> all;
+		std::array<std::array<uint64_t, MAX_THROUGH>, CELLS> through;
+		std::array<uint8_t, CELLS> count;
+
+		constexpr window_table() noexcept : all(), through(), count() {
+			int n = 0;
+			for(int d = 0; d < 4; d++){
+				for(int cell = 0; cell < CELLS; cell++){
+					if(STARTS[d] >> cell & 1){
+						all[n++] = line(SHIFTS[d]) << cell;
+					}
+				}
+			}
+			for(uint64_t window : all){
+				for(int cell = 0; cell < CELLS; cell++){
+					if(window >> cell & 1){
+						through[cell][count[cell]++] = window;
+					}
+				}
+			}
+		}
+	};
+
+	/* the board top row first with o for first's discs and x for second's, between rows of column numbers */
+	static void print(std::ostream& os, uint64_t first, uint64_t second){
+		for(int col = 0; col < W; ++col){
+			os << char('0' + col % 10);
+		}
+		os << std::endl;
+		for(int row = H - 1; row >= 0; --row){
+			for(int col = 0; col < W; ++col){
+				os << (first >> (row*W + col) & 1 ? 'o' : second >> (row*W + col) & 1 ? 'x' : '.');
+			}
+			os << std::endl;
+		}
+		for(int col = 0; col < W; ++col){
+			os << char('0' + col % 10);
+		}
+		os << std::endl;
+	}
+};
+
+template<typename... Boards>
+struct board_list { };
+
+using geometry = board<7,6,4>; // the standard board, the only one the book, the solver and the tools play on
+using boards = board_list<board<6,5,4>, geometry, board<8,7,4>, board<9,7,4>>; // the boards the bot plays, see run_bot
+
+extern template struct board<6,5,4>;
+extern template struct board<7,6,4>;
+extern template struct board<8,7,4>;
+extern template struct board<9,7,4>;
+
+#endif /* BOARD_H_ */
@@ -0,0 +1,105 @@
+/*
+ * Book.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Book.h"
+#include "Connect4.h"
+
+using namespace std;
+
+static const char MAGIC[4] = {'C', '4', 'B', 'K'};
+
+book::~book(){
+	close();
+}
+
+bool book::open(const string& path){
+	close();
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0){
+		return false;
+	}
+	struct stat info;
+	if(fstat(fd, &info) != 0 || size_t(info.st_size) < sizeof(header)){
+		::close(fd);
+		return false;
+	}
+	void* map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd); // the mapping keeps the file open
+	if(map == MAP_FAILED){
+		return false;
+	}
+	const header* head = static_cast<const header*>(map);
+	if(
+		memcmp(head->magic, MAGIC, sizeof(MAGIC)) != 0 || head->version != VERSION ||
+		head->count > (size_t(info.st_size) - sizeof(header)) / sizeof(record)
+	){
+		munmap(map, info.st_size);
+		return false;
+	}
+	map_ = map;
+	bytes_ = info.st_size;
+	records_ = reinterpret_cast<const record*>(static_cast<const char*>(map) + sizeof(header));
+	count_ = head->count;
+	return true;
+}
+
+void book::close() noexcept {
+	if(map_){
+		munmap(map_, bytes_);
+	}
+	map_ = nullptr;
+	bytes_ = 0;
+	records_ = nullptr;
+	count_ = 0;
+}
+
+const book::record* book::find(const state& s) const noexcept {
+	uint64_t k = key(s);
+	const record* end = records_ + count_;
+	const record* at = lower_bound(records_, end, k, [](const record& r, uint64_t k){
+		return r.key < k;
+	});
+	return at != end && at->key == k ? at : nullptr;
+}
+
+bool book::lookup(const state& s, int& choice) const noexcept {
+	const record* r = find(s);
+	if(r){
+		choice = r->choice;
+	}
+	return r;
+}
+
+uint64_t book::key(const state& s) noexcept {
+	return std::hash<const state>()(s);
+}
+
+void book::write(const string& path, vector<record> records){
+	sort(records.begin(), records.end(), [](const record& a, const record& b){
+		return a.key < b.key;
+	});
+	records.erase(unique(records.begin(), records.end(), [](const record& a, const record& b){
+		return a.key == b.key;
+	}), records.end());
+	header head;
+	memcpy(head.magic, MAGIC, sizeof(MAGIC));
+	head.version = VERSION;
+	head.count = records.size();
+	ofstream out(path, ios::binary | ios::trunc);
+	out.write(reinterpret_cast<const char*>(&head), sizeof(head));
+	out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(record));
+	if(!out){
+		throw runtime_error("could not write book " + path);
+	}
+}
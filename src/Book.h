@@ -0,0 +1,78 @@
+/*
+ * Book.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef BOOK_H_
+#define BOOK_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+template<typename Board>
+struct basic_state;
+using state = basic_state<geometry>; // the standard board's
+
+/**
+ * An opening book of the standard board mapped read only from a file written by BookBuilder. The file is a header followed by
+ * records sorted by key, in the byte order of the machine that built it, so lookups binary search the
+ * mapping in place.
+ */
+class book {
+public:
+	struct header {
+		char magic[4];
+		uint32_t version;
+		uint64_t count;
+	};
+	struct record {
+		uint64_t key;
+		int32_t score; // for players[0] like the heuristic
+		uint8_t choice;
+		uint8_t depth; // plies searched, 255 if solved
+		uint8_t reserved[2];
+	};
+	static constexpr uint32_t VERSION = 2; // 1 keyed positions by their discs column by column
+
+	book() noexcept : map_(nullptr), bytes_(0), records_(nullptr), count_(0) { }
+	~book();
+	book(const book&) = delete;
+	book& operator=(const book&) = delete;
+
+	/**
+	 * maps the book at path, returns false and leaves the book empty if the file is missing or not a book
+	 */
+	bool open(const std::string& path);
+	void close() noexcept;
+
+	/**
+	 * the record for the position, nullptr if the book doesn't have it
+	 */
+	const record* find(const state& s) const noexcept;
+	bool lookup(const state& s, int& choice) const noexcept;
+
+	std::size_t size() const noexcept {
+		return count_;
+	}
+
+	/**
+	 * identifies a position by its zobrist hash, the same in every run and including whose turn it is
+	 */
+	static uint64_t key(const state& s) noexcept;
+
+	/**
+	 * sorts records and writes them as a book to path, throws runtime_error if the file can't be written
+	 */
+	static void write(const std::string& path, std::vector<record> records);
+private:
+	void* map_;
+	std::size_t bytes_;
+	const record* records_;
+	std::size_t count_;
+};
+
+#endif /* BOOK_H_ */
@@ -0,0 +1,298 @@
+/*
+ * Bot.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <sstream>
+#include <bitset>
+#include <thread>
+#include <type_traits>
+#include "Bot.h"
+#include "Snapshot.hpp"
+
+using namespace std;
+using namespace dhlib::minimax;
+using namespace std::chrono;
+
+namespace {
+	constexpr size_t SNAPSHOT_PLIES = 10; // the tree below the empty board is what the next match can reuse
+
+	double ms(steady_clock::duration d){
+		return duration<double, milli>(d).count();
+	}
+}
+
+template<typename Game>
+basic_bot<Game>::basic_bot(Game& g, ostream& out, ostream& log, const string& snapshot) :
+	game_(g), out_(out), log_(log), snapshot_(snapshot), saved_(snapshot.empty()), turn_(false) {
+	if(snapshot_.size() && load_snapshot(game_.minimax, snapshot_)){
+		log_ << "WARM START: " << game_.minimax.pool.size() << " nodes, height " << game_.minimax.pool[game_.minimax.root].height << endl;
+	}
+	game_.minimax.aspiration(ASPIRATION);
+	game_.minimax.on_search([this](const search_stats& s){
+		search_stats copy = s;
+		searches_.push(copy);
+	});
+}
+
+/* logs the searches that finished since the last call, on the thread that called run */
+template<typename Game>
+void basic_bot<Game>::log_searches(){
+	search_stats s;
+	while(searches_.pop(s)){
+		log_ << "SEARCH: depth " << s.depth << " nodes " << s.nodes() << " ebf " << s.branching()
+			<< " cutoffs " << s.cutoff_rate() << " fails " << s.fail_lows << '/' << s.fail_highs << " nps " << s.nps() << " live " << s.live << endl;
+	}
+}
+
+template<typename Game>
+void basic_bot<Game>::run(istream& in, const vector<string>& read){
+	in.tie(nullptr); // reading would flush out_ on the reader thread while this one writes, replies flush themselves
+	for(const string& line : read){
+		command c;
+		c.line = line;
+		c.received = steady_clock::now();
+		handle(c);
+		log_searches();
+	}
+	thread reader([this, &in](){
+		command c;
+		bool more = true;
+		while(more){
+			more = bool(getline(in, c.line));
+			c.received = steady_clock::now();
+			c.end = !more;
+			if(c.line.size() && c.line.back() == '\r'){
+				c.line.pop_back();
+			}
+			while(!queue_.push(c)){
+				this_thread::yield();
+			}
+		}
+	});
+	command c;
+	while(true){
+		if(!queue_.pop(c)){ // the engine ponders on its own thread meanwhile
+			this_thread::sleep_for(POLL);
+			continue;
+		}
+		if(c.end){
+			break;
+		}
+		handle(c);
+		log_searches();
+	}
+	reader.join();
+	game_.minimax.stop_pondering();
+	log_searches();
+}
+
+/* the tree is kept before the first move leaves the empty board */
+template<typename Game>
+void basic_bot<Game>::save(){
+	if(!saved_){
+		saved_ = true;
+		try {
+			save_snapshot(game_.minimax, snapshot_, SNAPSHOT_PLIES);
+		} catch(const runtime_error& e){
+			log_ << e.what() << endl;
+		}
+	}
+}
+
+template<typename Game>
+void basic_bot<Game>::handle(const command& c){
+	stringstream in(c.line);
+	string word;
+	if(!(in >> word)){
+		return;
+	}
+	if(word == "settings"){
+		setting(in);
+	} else if(word == "update") {
+		in >> word;
+		if(word == "game") {
+			in >> word;
+			if(word == "round") {
+				in >> game_.round;
+			} else if(word == "field"){
+				field(in);
+			} else {
+				log_ << "bad update game: " << word << endl;
+			}
+		} else {
+			log_ << "bad update: " << word << endl;
+		}
+	} else if(word == "action"){
+		in >> word;
+		if(word == "move") {
+			in >> game_.timebank;
+			move(c);
+		} else {
+			log_ << "bad action: " << word << endl;
+		}
+	} else {
+		log_ << "bad command: " << word << endl;
+	}
+}
+
+template<typename Game>
+void basic_bot<Game>::setting(istream& in){
+	Settings& settings = game_.settings;
+	string word;
+	in >> word;
+	if(word == "timebank") {
+		in >> settings.timebank;
+	} else if(word == "time_per_move") {
+		in >> settings.time_per_move;
+	} else if(word == "player_names") {
+
+	} else if(word == "your_bot") {
+		in >> settings.your_bot;
+	} else if(word == "your_botid") {
+		in >> settings.your_botid;
+	} else if(word == "field_columns") {
+		in >> settings.field_columns;
+		if(settings.field_columns != board_type::WIDTH){ // run_bot picked the board before the bot started
+			log_ << "bad field_columns: " << settings.field_columns << ", playing " << board_type::WIDTH << endl;
+		}
+	} else if(word == "field_rows") {
+		in >> settings.field_rows;
+		if(settings.field_rows != board_type::HEIGHT){
+			log_ << "bad field_rows: " << settings.field_rows << ", playing " << board_type::HEIGHT << endl;
+		}
+	} else {
+		log_ << "bad setting: " << word << endl;
+	}
+}
+
+/* finds the disc the opponent dropped since our last move and plays it */
+template<typename Game>
+void basic_bot<Game>::field(istream& in){
+	if(!turn_){
+		uint64_t omove = 0;
+		string board;
+		in >> board;
+		for(int i = 0; i < board_type::CELLS && size_t(2*i) < board.size(); i++) {
+			int disc = board[2*i] - '0';
+			omove = (omove << 1) | (disc != 0 && disc != game_.settings.your_botid);
+		}
+		uint64_t disc = omove ^ game_.minimax.state().players[!(game_.settings.your_botid-1)];
+		log_ << "DISC: " << bitset<board_type::CELLS>(disc) << endl;
+		if(disc){ // disc is 0 for the start of the first round
+			uint64_t row = disc;
+			while(row >= (1 << board_type::WIDTH)){
+				row >>= board_type::WIDTH;
+			}
+			int choice = -1;
+			while(row){
+				row >>= 1;
+				choice++;
+			}
+			save();
+			try {
+				game_.minimax.progress(choice); // stops the ponder
+			} catch(const invalid_argument& e){
+				log_ << e.what() << endl;
+			}
+			log_searches();
+			log_ << "THEIR MOVE: " << choice << ':' << game_.minimax.score() << endl;
+			log_ << game_.minimax.state() << endl << endl;
+		}
+	}
+	turn_ = !turn_;
+}
+
+/* replies within the time action move gave, less whatever the command spent in the queue */
+template<typename Game>
+void basic_bot<Game>::move(const command& c){
+	const steady_clock::time_point begin = steady_clock::now();
+	const milliseconds budget = move_budget(game_);
+	const milliseconds waited = duration_cast<milliseconds>(begin - c.received);
+	game_.minimax.stop_pondering(); // our time now, whatever it found below their move is kept
+	log_searches();
+	choice choice;
+	if(!known_move(game_, choice)){ // out of book and too early to solve
+		game_.minimax.compute_for(max(budget - waited, milliseconds(1)));
+		choice = game_.minimax.choose(-1);
+	}
+	const steady_clock::time_point searched = steady_clock::now();
+	out_ << "place_disc " << board_type::WIDTH-1-choice << endl << flush;
+	const steady_clock::time_point replied = steady_clock::now();
+	log_searches();
+	log_ << "LATENCY: queued " << ms(begin - c.received) << " ms search " << ms(searched - begin)
+		<< " ms reply " << ms(replied - c.received) << " ms of " << budget.count() << " ms" << endl;
+	save();
+	try {
+		game_.minimax.progress(choice);
+	} catch(const invalid_argument& e){
+		log_ << e.what() << endl;
+	}
+	log_ << "MY MOVE: " << choice << ':' << game_.minimax.score() << endl;
+	log_ << game_.minimax.state() << endl << endl;
+	game_.minimax.ponder(); // searches on their time until their move reaches progress
+}
+
+template class basic_bot<basic_game<board<6,5,4>>>;
+template class basic_bot<game>;
+template class basic_bot<basic_game<board<8,7,4>>>;
+template class basic_bot<basic_game<board<9,7,4>>>;
+
+namespace {
+	/* plays in on Board, the standard board's game is the one with a book */
+	template<typename Board>
+	void play(istream& in, ostream& out, ostream& log, const string& openings, const string& snapshot, const vector<string>& read){
+		using Game = conditional_t<is_same<Board, geometry>::value, game, basic_game<Board>>;
+		Game g;
+		string path = snapshot;
+		if constexpr (is_same<Game, game>::value) {
+			if(openings.size() && !g.openings.open(openings)){
+				log << "not an opening book: " << openings << endl;
+			}
+		} else {
+			if(openings.size()){
+				log << "the book is for the standard board, not " << Board::WIDTH << 'x' << Board::HEIGHT << endl;
+			}
+			if(path.size()){
+				path += '.' + to_string(Board::WIDTH) + 'x' + to_string(Board::HEIGHT);
+			}
+		}
+		basic_bot<Game> b(g, out, log, path);
+		b.run(in, read);
+	}
+
+	template<typename... Boards>
+	bool play_on(board_list<Boards...>, short columns, short rows, istream& in, ostream& out, ostream& log, const string& openings, const string& snapshot, const vector<string>& read){
+		return ((Boards::WIDTH == columns && Boards::HEIGHT == rows && (play<Boards>(in, out, log, openings, snapshot, read), true)) || ...);
+	}
+}
+
+bool run_bot(istream& in, ostream& out, ostream& log, const string& openings, const string& snapshot){
+	short columns = geometry::WIDTH, rows = geometry::HEIGHT;
+	vector<string> read; // the settings, and the first line after them, the bot answers them again
+	string line;
+	while(getline(in, line)){
+		read.push_back(line);
+		stringstream words(line);
+		string word;
+		if(!(words >> word)){
+			continue;
+		}
+		if(word != "settings"){
+			break;
+		}
+		words >> word;
+		if(word == "field_columns"){
+			words >> columns;
+		} else if(word == "field_rows"){
+			words >> rows;
+		}
+	}
+	if(!play_on(boards(), columns, rows, in, out, log, openings, snapshot, read)){
+		log << "ERROR: no engine for a " << columns << 'x' << rows << " board" << endl;
+		return false;
+	}
+	return true;
+}
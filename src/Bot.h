@@ -0,0 +1,78 @@
+/*
+ * Bot.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef BOT_H_
+#define BOT_H_
+
+#include <chrono>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "Connect4.h"
+#include "Queue.hpp"
+
+/**
+ * Plays the competition protocol on Game, game or a basic_game: settings, update game round and field, and action
+ * move. A reader thread stamps every line with the time it arrived and hands it to the thread that called run through
+ * a lock-free queue, so reading never waits on a search and a search never waits on input. The engine ponders on its
+ * own thread between moves, and every reply logs how long its action move waited in the queue, searched and took in
+ * all. Only the thread that called run writes to the log, searches hand it their stats through a second queue.
+ */
+template<typename Game>
+class basic_bot {
+public:
+	using board_type = typename Game::board_type;
+	static constexpr std::size_t QUEUE_SIZE = 256; // lines in flight, the reader waits for room past this
+	static constexpr std::chrono::microseconds POLL = std::chrono::microseconds(100); // sleep while the queue is empty
+	static constexpr std::size_t SEARCHES_SIZE = 16; // search stats not yet logged, later ones are dropped past this
+	static constexpr score ASPIRATION = 4; // the window the tree searches the root in after a move, see minimax::aspiration
+
+	/**
+	 * snapshot, unless empty, warm starts the tree and gets the top of it back before the first move is played
+	 */
+	basic_bot(Game& g, std::ostream& out, std::ostream& log, const std::string& snapshot = "");
+
+	/**
+	 * answers the lines already read from in, then the commands read from in until it ends
+	 */
+	void run(std::istream& in, const std::vector<std::string>& read = std::vector<std::string>());
+private:
+	struct command {
+		std::string line;
+		std::chrono::steady_clock::time_point received;
+		bool end = false; // in ended, nothing follows
+	};
+
+	void handle(const command& c);
+	void setting(std::istream& in);
+	void field(std::istream& in);
+	void move(const command& c);
+	void save();
+	void log_searches();
+
+	Game& game_;
+	std::ostream& out_;
+	std::ostream& log_;
+	std::string snapshot_;
+	bool saved_;
+	bool turn_; // every other field update follows our own move and has nothing new
+	dhlib::minimax::spsc_queue<command, QUEUE_SIZE> queue_;
+	// filled by the search hook on the thread that searched, the ponder thread or this one, never both at once as
+	// every search stops the ponder first, so the queue still has one producer at a time
+	dhlib::minimax::spsc_queue<dhlib::minimax::search_stats, SEARCHES_SIZE> searches_;
+};
+
+using bot = basic_bot<game>;
+
+/**
+ * Reads the settings at the start of in and plays the rest of it on the board their field_columns and field_rows
+ * name, the standard board if they name none. The book is only opened for the standard board, the other boards keep
+ * their snapshot at snapshot with .<columns>x<rows> added. Returns false without playing if the engine isn't built
+ * for the board, see boards.
+ */
+bool run_bot(std::istream& in, std::ostream& out, std::ostream& log, const std::string& openings = "", const std::string& snapshot = "");
+
+#endif /* BOT_H_ */
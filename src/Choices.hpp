@@ -0,0 +1,219 @@
+/*
+ * Choices.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef CHOICES_H_
+#define CHOICES_H_
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dhlib { namespace minimax {
+
+	/**
+	 * A list of at most N values kept inline rather than on the heap, with the parts of std::vector the tree uses.
+	 * T must be default constructible.
+	 */
+	template<typename T, std::size_t N>
+	class fixed_list {
+	public:
+		using value_type = T;
+		using iterator = value_type*;
+		using const_iterator = const value_type*;
+		using size_type = std::conditional_t<(N <= std::numeric_limits<std::uint8_t>::max()), std::uint8_t, std::size_t>;
+		static constexpr std::size_t CAPACITY = N;
+
+		fixed_list() noexcept : size_(0) { }
+
+		template<typename... Args>
+		value_type& emplace_back(Args&&... args) {
+			assert(size_ < N);
+			items_[size_] = value_type(std::forward<Args>(args)...);
+			return items_[size_++];
+		}
+		void push_back(const value_type& value) {
+			emplace_back(value);
+		}
+		void clear() noexcept {
+			size_ = 0;
+		}
+		void reserve(std::size_t count) noexcept {
+			assert(count <= N);
+			(void)count;
+		}
+
+		iterator begin() noexcept {
+			return items_.data();
+		}
+		iterator end() noexcept {
+			return items_.data() + size_;
+		}
+		const_iterator begin() const noexcept {
+			return items_.data();
+		}
+		const_iterator end() const noexcept {
+			return items_.data() + size_;
+		}
+		const_iterator cbegin() const noexcept {
+			return begin();
+		}
+		const_iterator cend() const noexcept {
+			return end();
+		}
+		value_type& operator[](std::size_t i) noexcept {
+			return items_[i];
+		}
+		const value_type& operator[](std::size_t i) const noexcept {
+			return items_[i];
+		}
+		value_type& front() noexcept {
+			return items_[0];
+		}
+		const value_type& front() const noexcept {
+			return items_[0];
+		}
+		value_type& back() noexcept {
+			return items_[size_ - 1];
+		}
+		const value_type& back() const noexcept {
+			return items_[size_ - 1];
+		}
+		std::size_t size() const noexcept {
+			return size_;
+		}
+		std::size_t capacity() const noexcept {
+			return N;
+		}
+		bool empty() const noexcept {
+			return size_ == 0;
+		}
+	private:
+		std::array<value_type, N> items_;
+		size_type size_;
+	};
+
+	/**
+	 * A fixed capacity list of a state's children that lives on the stack, for GetChoices that never have
+	 * more than N. State must be default constructible.
+	 */
+	template<typename Choice, typename State, std::size_t N>
+	using choice_buffer = fixed_list<std::pair<Choice, State>, N>;
+
+	namespace details {
+		/* GetChoices::MAX_CHOICES when GetChoices can fill a choice_buffer that large, or 0 when it only returns containers */
+		template<typename GetChoices, typename = void>
+		struct max_choices : std::integral_constant<std::size_t, 0> { };
+		template<typename GetChoices>
+		struct max_choices<GetChoices, std::void_t<decltype(GetChoices::MAX_CHOICES)>> : std::integral_constant<std::size_t, GetChoices::MAX_CHOICES> { };
+
+		/* a node's list of T, inline when GetChoices has MAX_CHOICES and a vector otherwise */
+		template<typename T, typename GetChoices>
+		using node_list = std::conditional_t<max_choices<GetChoices>::value != 0,
+			fixed_list<T, max_choices<GetChoices>::value>, std::vector<T>>;
+
+		/* the children of state, in a choice_buffer when GetChoices supports one so nothing is allocated */
+		template<typename Choice, typename State, typename GetChoices>
+		auto children_of(GetChoices &getChoices, const State &state) {
+			if constexpr (max_choices<GetChoices>::value != 0) {
+				choice_buffer<Choice, State, max_choices<GetChoices>::value> children;
+				getChoices(state, children);
+				return children;
+			} else {
+				return getChoices(state);
+			}
+		}
+
+		/**
+		 * whether GetChoices has a static bool play(State, Choice, State& child) making the child a choice leads to
+		 * without the others, for any legal choice, even one GetChoices leaves out
+		 */
+		template<typename GetChoices, typename State, typename Choice, typename = void>
+		struct playable : std::false_type { };
+		template<typename GetChoices, typename State, typename Choice>
+		struct playable<GetChoices, State, Choice, std::void_t<decltype(
+			GetChoices::play(std::declval<const State&>(), std::declval<const Choice&>(), std::declval<State&>())
+		)>> : std::true_type { };
+
+		/* the child choice leads to from state, the same one GetChoices makes, false if it can't be played */
+		template<typename Choice, typename State, typename GetChoices>
+		bool play(GetChoices &getChoices, const State &state, const Choice &choice, State &child) {
+			if constexpr (playable<GetChoices, State, Choice>::value) {
+				return GetChoices::play(state, choice, child);
+			} else {
+				for(auto &c : children_of<Choice>(getChoices, state)){
+					if(c.first == choice){
+						child = c.second;
+						return true;
+					}
+				}
+				return false;
+			}
+		}
+
+		/* GetChoices::SYMMETRIC when GetChoices has static mirror(State) and mirror(Choice) reflecting the game, or false */
+		template<typename GetChoices, typename = void>
+		struct symmetric : std::false_type { };
+		template<typename GetChoices>
+		struct symmetric<GetChoices, std::void_t<decltype(GetChoices::SYMMETRIC)>> : std::integral_constant<bool, GetChoices::SYMMETRIC> { };
+
+		/* whether GetChoices has a static mirror_hash(State), the hash of a state's mirror without building the mirror */
+		template<typename GetChoices, typename State, typename = void>
+		struct mirror_hashed : std::false_type { };
+		template<typename GetChoices, typename State>
+		struct mirror_hashed<GetChoices, State, std::void_t<decltype(GetChoices::mirror_hash(std::declval<const State&>()))>> : std::true_type { };
+
+		/**
+		 * the hash of whichever of state and its mirror hashes lower, so both find the same table entries, mirrored is set
+		 * when that is the mirror. Choices go in the table as they are in the orientation hashed, see orient.
+		 */
+		template<typename GetChoices, typename State>
+		std::uint64_t canonical_hash(const State& state, bool& mirrored) noexcept {
+			std::uint64_t key = std::hash<const State>()(state);
+			mirrored = false;
+			if constexpr (symmetric<GetChoices>::value) {
+				std::uint64_t reflected;
+				if constexpr (mirror_hashed<GetChoices, State>::value) {
+					reflected = GetChoices::mirror_hash(state);
+				} else {
+					reflected = std::hash<const State>()(GetChoices::mirror(state));
+				}
+				if(reflected < key){
+					mirrored = true;
+					return reflected;
+				}
+			}
+			return key;
+		}
+
+		/* choice reflected when mirrored, a mirror undoes itself so this maps both to and from the canonical orientation */
+		template<typename GetChoices, typename Choice>
+		Choice orient(const Choice& choice, bool mirrored) noexcept {
+			if constexpr (symmetric<GetChoices>::value) {
+				return mirrored ? GetChoices::mirror(choice) : choice;
+			} else {
+				return choice;
+			}
+		}
+
+		/* whether a and b are the same position, as they are or reflected */
+		template<typename GetChoices, typename State>
+		bool equivalent(const State& a, const State& b) {
+			if constexpr (symmetric<GetChoices>::value) {
+				return a == b || a == GetChoices::mirror(b);
+			} else {
+				return a == b;
+			}
+		}
+	}
+} }
+
+#endif /* CHOICES_H_ */
@@ -0,0 +1,312 @@
+/*
+ * Compact.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef COMPACT_H_
+#define COMPACT_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "Minimax.hpp"
+
+namespace dhlib { namespace minimax {
+
+	/**
+	 * A minimax tree kept as a structure of arrays instead of linked nodes. A node is an index into parallel arrays
+	 * of its score, first child, child count, flags and the choice that leads to it, NODE_BYTES in all, and the
+	 * children of a node are contiguous. States aren't stored but replayed from the root as a search descends,
+	 * with GetChoices::play when it has one. Positions aren't shared, one reached in another order is searched
+	 * again. compute deepens an alpha-beta search over the tree that expands the leaves it reaches and leaves every
+	 * node's children best first for the next iteration.
+	 */
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
+	class compact_tree {
+	public:
+		using index = std::uint32_t;
+		static constexpr std::size_t NODE_BYTES = sizeof(Score) + sizeof(index) + 2 * sizeof(std::uint8_t) + sizeof(Choice);
+		static constexpr std::size_t MAX_CHILDREN = std::numeric_limits<std::uint8_t>::max();
+
+		compact_tree(const State& root, bool type) : state_(root), type_(type), height_(0), visited_(0) {
+			add(Choice(), heuristic_(root));
+		}
+
+		/**
+		 * searches the root to height plies, from the height the last compute reached
+		 */
+		void compute(std::size_t height) {
+			visited_ = 0;
+			for(std::size_t depth = height_ + 1; depth <= height; ++depth){
+				search(0, state_, type_, depth, std::numeric_limits<Score>::lowest(), std::numeric_limits<Score>::max());
+				height_ = depth;
+			}
+		}
+
+		/**
+		 * the best choice at the root, or def if it has no children
+		 */
+		Choice choose(const Choice& def) const noexcept {
+			return count_[0] ? choice_[first_[0]] : def;
+		}
+
+		/**
+		 * moves the root to the child choice leads to, keeping its subtree, throws invalid_argument if it can't be played
+		 */
+		State progress(const Choice& choice) {
+			index next = NONE;
+			for(index c = first_[0]; c < first_[0] + count_[0]; ++c){
+				if(choice_[c] == choice){
+					next = c;
+				}
+			}
+			State child;
+			if(!details::play(getChoices_, state_, choice, child)){
+				throw std::invalid_argument("invalid choice");
+			}
+			if(next == NONE){ // not searched yet or left out by GetChoices
+				clear();
+				add(Choice(), heuristic_(child));
+			} else {
+				keep(next);
+			}
+			state_ = child;
+			type_ = !type_;
+			height_ = next == NONE || height_ == 0 ? 0 : height_ - 1;
+			return state_;
+		}
+
+		/**
+		 * calls visit(node, depth) for every node, parents before their children
+		 */
+		template<typename Visit>
+		void walk(Visit visit) const {
+			walk(0, 0, visit);
+		}
+
+		/**
+		 * calls visit(node, state, depth) for every node, parents before their children, replaying their states
+		 */
+		template<typename Visit>
+		void replay(Visit visit) const {
+			replay(0, state_, 0, visit);
+		}
+
+		Score score() const noexcept {
+			return score_[0];
+		}
+		Score score(index node) const noexcept {
+			return score_[node];
+		}
+		const State& state() const noexcept {
+			return state_;
+		}
+		bool type() const noexcept {
+			return type_;
+		}
+		std::size_t height() const noexcept {
+			return height_;
+		}
+
+		/**
+		 * nodes in the tree, the bytes the arrays hold and the nodes the last compute searched
+		 */
+		std::size_t size() const noexcept {
+			return score_.size();
+		}
+		std::size_t bytes() const noexcept {
+			return score_.capacity() * sizeof(Score) + first_.capacity() * sizeof(index) +
+				count_.capacity() + flags_.capacity() + choice_.capacity() * sizeof(Choice);
+		}
+		std::size_t visited() const noexcept {
+			return visited_;
+		}
+	private:
+		static constexpr index NONE = std::numeric_limits<index>::max();
+		static constexpr std::uint8_t EXPANDED = 1; // flags, first and count are set even if it has no children
+
+		index add(const Choice& choice, const Score& score) {
+			if(score_.size() == NONE){
+				throw std::length_error("compact tree full");
+			}
+			score_.push_back(score);
+			first_.push_back(NONE);
+			count_.push_back(0);
+			flags_.push_back(0);
+			choice_.push_back(choice);
+			return score_.size() - 1;
+		}
+
+		void clear() noexcept {
+			score_.clear();
+			first_.clear();
+			count_.clear();
+			flags_.clear();
+			choice_.clear();
+		}
+
+		/* adds the children of n after every other node, scored by the heuristic */
+		void expand(index n, const State& s) {
+			auto children = details::children_of<Choice>(getChoices_, s);
+			if(children.size() > MAX_CHILDREN){
+				throw std::length_error("too many children for a compact tree");
+			}
+			const index first = score_.size();
+			if constexpr (details::batched<Heuristic, State, Score>::value) {
+				states_.clear();
+				for(auto &child : children){
+					states_.push_back(child.second);
+				}
+				scores_.resize(states_.size());
+				heuristic_(states_.data(), scores_.data(), states_.size());
+				for(std::size_t i = 0; i < states_.size(); ++i){
+					add(children[i].first, scores_[i]);
+				}
+			} else {
+				for(auto &child : children){
+					add(child.first, heuristic_(child.second));
+				}
+			}
+			first_[n] = first;
+			count_[n] = children.size();
+			flags_[n] |= EXPANDED;
+		}
+
+		/**
+		 * sorts n's children best first for type, their subtrees move with them as only first says where they are.
+		 * A fail soft search leaves bounds on the children it cut off that can tie the best, so the best goes first.
+		 */
+		void order(index n, bool type, index best = NONE) {
+			const index first = first_[n], count = count_[n];
+			std::array<index, MAX_CHILDREN> by;
+			for(index i = 0; i < count; ++i){
+				by[i] = first + i;
+			}
+			std::stable_sort(by.begin(), by.begin() + count, [this, type, best](index a, index b){
+				if(score_[a] == score_[b]){
+					return a == best && b != best;
+				}
+				return type ? score_[a] > score_[b] : score_[a] < score_[b];
+			});
+			permute(score_, first, count, by);
+			permute(first_, first, count, by);
+			permute(count_, first, count, by);
+			permute(flags_, first, count, by);
+			permute(choice_, first, count, by);
+		}
+		template<typename T>
+		static void permute(std::vector<T>& values, index first, index count, const std::array<index, MAX_CHILDREN>& by) {
+			std::array<T, MAX_CHILDREN> moved;
+			for(index i = 0; i < count; ++i){
+				moved[i] = values[by[i]];
+			}
+			std::copy(moved.begin(), moved.begin() + count, values.begin() + first);
+		}
+
+		/* fail soft alpha-beta, score_ keeps what every searched node returned */
+		Score search(index n, const State& s, bool type, std::size_t depth, Score alpha, Score beta) {
+			++visited_;
+			if(depth == 0){
+				return flags_[n] & EXPANDED ? heuristic_(s) : score_[n]; // a leaf's score is its heuristic
+			}
+			if(!(flags_[n] & EXPANDED)){
+				expand(n, s);
+				order(n, type);
+			}
+			const index first = first_[n], count = count_[n];
+			if(count == 0){
+				return score_[n];
+			}
+			Score best = type ? std::numeric_limits<Score>::lowest() : std::numeric_limits<Score>::max();
+			index bestChild = first;
+			State child;
+			for(index c = first; c < first + count; ++c){
+				details::play(getChoices_, s, choice_[c], child);
+				Score value = search(c, child, !type, depth - 1, alpha, beta);
+				if(type ? value > best : value < best){
+					best = value;
+					bestChild = c;
+				}
+				if(type){
+					alpha = std::max(alpha, value);
+				} else {
+					beta = std::min(beta, value);
+				}
+				if(alpha >= beta){
+					break;
+				}
+			}
+			score_[n] = best;
+			order(n, type, bestChild);
+			return best;
+		}
+
+		/* makes old the root, copying its subtree breadth first to the front so sibling blocks stay contiguous */
+		void keep(index old) {
+			std::vector<Score> score = {score_[old]};
+			std::vector<index> first = {NONE};
+			std::vector<std::uint8_t> count = {count_[old]}, flags = {flags_[old]};
+			std::vector<Choice> choice = {Choice()};
+			std::vector<index> from = {old};
+			for(index i = 0; i < from.size(); ++i){
+				const index o = from[i];
+				if(!(flags_[o] & EXPANDED)){
+					continue;
+				}
+				first[i] = from.size();
+				for(index c = first_[o]; c < first_[o] + count_[o]; ++c){
+					from.push_back(c);
+					score.push_back(score_[c]);
+					first.push_back(NONE);
+					count.push_back(count_[c]);
+					flags.push_back(flags_[c]);
+					choice.push_back(choice_[c]);
+				}
+			}
+			score_.swap(score);
+			first_.swap(first);
+			count_.swap(count);
+			flags_.swap(flags);
+			choice_.swap(choice);
+		}
+
+		template<typename Visit>
+		void walk(index n, std::size_t depth, Visit& visit) const {
+			visit(n, depth);
+			for(index c = first_[n]; c < first_[n] + count_[n]; ++c){
+				walk(c, depth + 1, visit);
+			}
+		}
+
+		template<typename Visit>
+		void replay(index n, const State& s, std::size_t depth, Visit& visit) const {
+			visit(n, s, depth);
+			GetChoices getChoices;
+			State child;
+			for(index c = first_[n]; c < first_[n] + count_[n]; ++c){
+				details::play(getChoices, s, choice_[c], child);
+				replay(c, child, depth + 1, visit);
+			}
+		}
+
+		std::vector<Score> score_; // from the heuristic for leaves, the last search for the rest
+		std::vector<index> first_;
+		std::vector<std::uint8_t> count_;
+		std::vector<std::uint8_t> flags_;
+		std::vector<Choice> choice_; // the choice leading to the node from its parent
+		State state_;
+		bool type_;
+		std::size_t height_;
+		std::size_t visited_;
+		GetChoices getChoices_;
+		Heuristic heuristic_;
+		std::vector<State> states_; // the batch handed to the heuristic, kept to reuse the memory
+		std::vector<Score> scores_;
+	};
+} }
+
+#endif /* COMPACT_H_ */
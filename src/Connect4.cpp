@@ -18,8 +18,9 @@ using namespace std;
 using namespace dhlib::minimax;
 using namespace std::chrono;
 
-constexpr int infinity = 20000;
-constexpr int threshhold = infinity / 2;
+#ifndef CONNECT4_SHIFT_EVAL
+#define CONNECT4_SHIFT_EVAL 1 // score_board and check_winner use whole board shifts rather than window scans
+#endif
 
 #ifdef __GNUC__
 unsigned int bit_count(uint64_t x){
@@ -33,77 +34,67 @@ unsigned int bit_count(uint64_t i){ // magic code copied from stack overflow
 }
 #endif
 
-size_t std::hash<const state>::operator()(const state& s) const noexcept {
-		return hash<uint64_t>()(s.players[0]) ^ hash<uint64_t>()(s.players[1]+0xd586d8560da3d3b7);
-}
-
-bool operator==(const state& s1, const state& s2){
-	return s1.turn == s2.turn && std::equal(s1.players.begin(), s1.players.end(), s2.players.begin());
+static constexpr uint64_t mix(uint64_t x){ // splitmix64 finalizer
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+	return x ^ (x >> 31);
 }
 
-ostream& operator<<(std::ostream& os, const state& s){
-	os << "0123456" << endl;
-	for(int row = 5; row >= 0; --row){
-		for(int col = 0; col < 7; ++col){ // we reflect the columns so the indexes go left to right
-			if(s.players[0] >> (row*7 + col) & 1){
-				os << 'o';
-			} else if(s.players[1] >> (row*7 + col) & 1){
-				os << 'x';
-			} else {
-				os << '.';
+/*
+ * Zobrist keys for a disc of each player in each cell, drawn from splitmix64 with a fixed seed so a position has the
+ * same hash in every run, book and snapshot. A cell's key is its mirror cell's rotated half a word and the centre
+ * column's keys are their own rotations, like TURN_KEY, so the mirror of a board hashes to its hash rotated.
+ */
+template<typename Board>
+struct zobrist_keys {
+	array<array<uint64_t, Board::CELLS>, 2> cells;
+	constexpr zobrist_keys() : cells() {
+		uint64_t seed = 0x5a6f62726973744bull;
+		auto next = [&seed](){
+			seed += 0x9e3779b97f4a7c15;
+			return mix(seed);
+		};
+		for(int player = 0; player < 2; player++){
+			for(int cell = 0; cell < Board::CELLS; cell++){
+				int col = cell % Board::WIDTH, reflected = cell - col + Board::WIDTH - 1 - col;
+				if(reflected > cell){
+					cells[player][cell] = next();
+					cells[player][reflected] = rotate_key(cells[player][cell]);
+				} else if(reflected == cell){
+					uint64_t half = next() >> 32;
+					cells[player][cell] = half << 32 | half;
+				}
 			}
 		}
-		os << endl;
 	}
-	os << "0123456" << endl;
-	return os;
-}
+};
 
-const uint64_t makeBoard(const initializer_list<int> mask){
-	uint64_t uint = 0;
-	for(auto bit = mask.begin(); bit != mask.end(); ++bit){
-		uint = (uint << 1) | *bit;
-	}
-	return uint;
-}
+template<typename Board>
+static constexpr zobrist_keys<Board> ZOBRIST = zobrist_keys<Board>();
 
-const uint64_t ROW_MASK = makeBoard({
-	1,1,1,1
-});
-
-const uint64_t COLUMN_MASK = makeBoard({
-	0,0,0,0,0,0,1,
-	0,0,0,0,0,0,1,
-	0,0,0,0,0,0,1,
-	0,0,0,0,0,0,1
-});
-
-const uint64_t BACKWARD_DIAG_MASK = makeBoard({
-	0,0,0,0,0,0,1,
-	0,0,0,0,0,1,0,
-	0,0,0,0,1,0,0,
-	0,0,0,1,0,0,0
-});
-
-const uint64_t FORWARD_DIAG_MASK = makeBoard({
-	0,0,0,1,0,0,0,
-	0,0,0,0,1,0,0,
-	0,0,0,0,0,1,0,
-	0,0,0,0,0,0,1
-});
+template struct board<6,5,4>;
+template struct board<7,6,4>;
+template struct board<8,7,4>;
+template struct board<9,7,4>;
+
+constexpr int WIDTH = geometry::WIDTH, HEIGHT = geometry::HEIGHT, RUN = geometry::RUN, CELLS = geometry::CELLS;
+constexpr uint64_t ROW_MASK = geometry::line(1);
+constexpr uint64_t COLUMN_MASK = geometry::line(WIDTH);
+constexpr uint64_t BACKWARD_DIAG_MASK = geometry::line(WIDTH - 1) << (RUN - 1);
+constexpr uint64_t FORWARD_DIAG_MASK = geometry::line(WIDTH + 1);
 
 static int square(int x){
 	return x*x;
 }
 
-int score_board(const state& board){
+int scan_board(const state& board){
 	int score = 0;
 	const uint64_t mine = board.players[0];
 	const uint64_t theirs = board.players[1];
 	bool won = false;
 	bool lost = false;
-	for(uint64_t mRow = mine, tRow = theirs; mRow; mRow >>= 7, tRow >>= 7){ // ---'s
-		for(int i = 0; i < 4; i++){
+	for(uint64_t mRow = mine, tRow = theirs; mRow | tRow; mRow >>= WIDTH, tRow >>= WIDTH){ // ---'s
+		for(int i = 0; i <= WIDTH - RUN; i++){
 			unsigned mwindow = (mRow >> i) & ROW_MASK;
 			unsigned twindow = (tRow >> i) & ROW_MASK;
 			if(mwindow == ROW_MASK){
@@ -120,7 +111,7 @@ int score_board(const state& board){
 			}
 		}
 	}
-	for(int i = 0; i < 21; i++){ // |'s
+	for(int i = 0; i < (HEIGHT - RUN + 1) * WIDTH; i++){ // |'s
 		uint64_t mShifted= (mine >> i) & COLUMN_MASK;
 		uint64_t tShifted = (theirs >> i) & COLUMN_MASK;
 		if(mShifted == COLUMN_MASK){
@@ -136,12 +127,12 @@ int score_board(const state& board){
 			}
 		}
 	}
-	for(int i = 0; i < 4; i++){ // \'s
+	for(int i = 0; i <= WIDTH - RUN; i++){ // \'s
 		uint64_t mShifted = mine >> i;
 		uint64_t tShifted = theirs >> i;
-		for(int j = 0; j < 3; j++){
-			uint64_t mWindow = (mShifted >> 7*j) & BACKWARD_DIAG_MASK;
-			uint64_t tWindow = (tShifted >> 7*j) & BACKWARD_DIAG_MASK;
+		for(int j = 0; j <= HEIGHT - RUN; j++){
+			uint64_t mWindow = (mShifted >> WIDTH*j) & BACKWARD_DIAG_MASK;
+			uint64_t tWindow = (tShifted >> WIDTH*j) & BACKWARD_DIAG_MASK;
 			if(mWindow == BACKWARD_DIAG_MASK){
 				won = true;
 			} else if(tWindow == BACKWARD_DIAG_MASK){
@@ -156,12 +147,12 @@ int score_board(const state& board){
 			}
 		}
 	}
-	for(int i = 0; i < 4; i++){ // /'s
+	for(int i = 0; i <= WIDTH - RUN; i++){ // /'s
 		uint64_t mShifted = mine >> i;
 		uint64_t tShifted = theirs >> i;
-		for(int j = 0; j < 3; j++){
-			uint64_t mWindow = (mShifted >> 7*j) & FORWARD_DIAG_MASK;
-			uint64_t tWindow = (tShifted >> 7*j) & FORWARD_DIAG_MASK;
+		for(int j = 0; j <= HEIGHT - RUN; j++){
+			uint64_t mWindow = (mShifted >> WIDTH*j) & FORWARD_DIAG_MASK;
+			uint64_t tWindow = (tShifted >> WIDTH*j) & FORWARD_DIAG_MASK;
 			if(mWindow == FORWARD_DIAG_MASK){
 				won = true;
 			} else if(tWindow == FORWARD_DIAG_MASK){
@@ -188,47 +179,143 @@ int score_board(const state& board){
 	return score;
 }
 
-int heuristic::operator()(const state& state) const noexcept {
-	return score_board(state);
+template<typename Board>
+static constexpr typename Board::window_table WINDOWS = typename Board::window_table(); // the windows through every cell, built by the compiler
+
+/* a window's share of score_board, complete windows decide the game instead */
+template<typename Board>
+static int window_score(unsigned mine, unsigned theirs){
+	if(mine == Board::RUN || theirs == Board::RUN){
+		return 0;
+	}
+	return (mine == 0 ? -square(theirs) : 0) + (theirs == 0 ? square(mine) : 0);
 }
 
-bool check_winner(uint64_t board, int row, int col){
-	uint64_t shifted = board >> 7*row;
-	for(int i = 0; i < 4; i++){
+template<typename Board>
+void basic_state<Board>::place(bool player, int cell) noexcept {
+	for(int i = 0; i < WINDOWS<Board>.count[cell]; i++){
+		uint64_t window = WINDOWS<Board>.through[cell][i];
+		unsigned mine = bit_count(players[0] & window);
+		unsigned theirs = bit_count(players[1] & window);
+		eval -= window_score<Board>(mine, theirs);
+		if(player){
+			++theirs;
+		} else {
+			++mine;
+		}
+		eval += window_score<Board>(mine, theirs);
+		if((player ? theirs : mine) == Board::RUN){
+			++fours[player];
+		}
+	}
+	players[player] |= uint64_t(1) << cell;
+	key ^= ZOBRIST<Board>.cells[player][cell];
+}
+
+template<typename Board>
+void basic_state<Board>::rescore() noexcept {
+	eval = 0;
+	fours = {0, 0};
+	key = 0;
+	for(int player = 0; player < 2; player++){
+		for(uint64_t discs = players[player]; discs; discs &= discs - 1){
+			key ^= ZOBRIST<Board>.cells[player][__builtin_ctzll(discs)];
+		}
+	}
+	for(uint64_t window : WINDOWS<Board>.all){
+		unsigned mine = bit_count(players[0] & window);
+		unsigned theirs = bit_count(players[1] & window);
+		eval += window_score<Board>(mine, theirs);
+		fours[0] += mine == Board::RUN;
+		fours[1] += theirs == Board::RUN;
+	}
+}
+
+template<typename Board>
+int evaluate(const basic_state<Board>& board){
+	if(board.fours[0] && board.fours[1]){
+		throw invalid_argument("invalid game state both players with winning arrangement");
+	}
+	if(board.fours[0]){
+		return infinity - bit_count(board.players[1]);
+	}
+	if(board.fours[1]){
+		return 100*bit_count(board.players[0]) - infinity + board.eval;
+	}
+	return board.eval;
+}
+
+template<typename Board>
+score basic_heuristic<Board>::operator()(const basic_state<Board>& state) const noexcept {
+	return evaluate(state);
+}
+
+template<typename Board>
+void basic_heuristic<Board>::operator()(const basic_state<Board>* states, score* scores, size_t count) const noexcept {
+	for(size_t i = 0; i < count; ++i){ // a search never reaches a board where both players have four
+		const basic_state<Board>& s = states[i];
+		int won = infinity - int(bit_count(s.players[1]));
+		int lost = 100*int(bit_count(s.players[0])) - infinity + s.eval;
+		scores[i] = s.fours[0] ? won : s.fours[1] ? lost : s.eval;
+	}
+}
+
+int shift_board(const state& board){
+	uint64_t won = 0, lost = 0;
+	int score = geometry::score(board.players[0], board.players[1], won, lost);
+	if(won && lost){
+		throw invalid_argument("invalid game state both players with winning arrangement");
+	}
+	if(won){
+		return infinity - bit_count(board.players[1]);
+	}
+	if(lost){
+		return 100*bit_count(board.players[0]) - infinity + score;
+	}
+	return score;
+}
+
+int score_board(const state& board){
+#if CONNECT4_SHIFT_EVAL
+	return shift_board(board);
+#else
+	return scan_board(board);
+#endif
+}
+
+bool shift_winner(uint64_t board){
+	return geometry::lines(board) != 0;
+}
+
+bool scan_winner(uint64_t board, int row, int col){
+	uint64_t shifted = board >> WIDTH*row;
+	for(int i = 0; i <= WIDTH - RUN; i++){
 		unsigned window = (shifted >> i) & ROW_MASK;
 		if(window == ROW_MASK){
 			return true;
 		}
 	}
 	shifted = board >> col;
-	for(int j = 0; j < 3; j++){
+	for(int j = 0; j <= HEIGHT - RUN; j++){
 		uint64_t window = shifted & COLUMN_MASK;
 		if(window == COLUMN_MASK){
 			return true;
 		}
-		shifted >>= 7;
+		shifted >>= WIDTH;
 	}
-	shifted = board >> col;
-	for(int j = 0; j < 3; j++){
-		uint64_t window = shifted & BACKWARD_DIAG_MASK;
-		if(window == BACKWARD_DIAG_MASK){
-			return true;
-		}
-		shifted >>= 7;
-	}
-	for(int i = 0; i <= min(3, col); i++){ // /'s
+	for(int i = 0; i <= min(WIDTH - RUN, col); i++){ // /'s
 		shifted = board >> i;
-		for(int j = 0; j <= min(2, row); j++){
-			uint64_t window = (shifted >> 7*j) & FORWARD_DIAG_MASK;
+		for(int j = 0; j <= min(HEIGHT - RUN, row); j++){
+			uint64_t window = (shifted >> WIDTH*j) & FORWARD_DIAG_MASK;
 			if(window == FORWARD_DIAG_MASK){
 				return true;
 			}
 		}
 	}
-	for(int i = 0; i <= min(3, col); i++){ // \'s
+	for(int i = 0; i <= min(WIDTH - RUN, col); i++){ // \'s
 		shifted = board >> i;
-		for(int j = 0; j <= min(2, row); j++){
-			uint64_t window = (shifted >> 7*j) & BACKWARD_DIAG_MASK;
+		for(int j = 0; j <= min(HEIGHT - RUN, row); j++){
+			uint64_t window = (shifted >> WIDTH*j) & BACKWARD_DIAG_MASK;
 			if(window == BACKWARD_DIAG_MASK){
 				return true;
 			}
@@ -237,53 +324,161 @@ bool check_winner(uint64_t board, int row, int col){
 	return false;
 }
 
-const size_t get_choices::SEED(std::chrono::system_clock::now().time_since_epoch().count());
-std::default_random_engine get_choices::random(get_choices::SEED);
+bool check_winner(uint64_t board, int row, int col){
+#if CONNECT4_SHIFT_EVAL
+	return shift_winner(board);
+#else
+	return scan_winner(board, row, col);
+#endif
+}
+
+size_t choice_random::SEED(std::chrono::system_clock::now().time_since_epoch().count());
+thread_local std::default_random_engine choice_random::random(choice_random::SEED);
+
+void choice_random::seed(size_t value){
+	SEED = value;
+	random.seed(value);
+}
+
+void choice_random::seed_thread(size_t value) noexcept {
+	random.seed(value);
+}
+
+bool choice_random::randomize(true);
+
+template<typename Board>
+basic_state<Board> basic_get_choices<Board>::mirror(const state_type& s) noexcept {
+	state_type reflected = s; // the window totals are the same seen from either side
+	reflected.players[0] = Board::mirror(s.players[0]);
+	reflected.players[1] = Board::mirror(s.players[1]);
+	reflected.key = rotate_key(s.key);
+	return reflected;
+}
+
+template<typename Board>
+size_t basic_get_choices<Board>::key(const state_type& from, const choice&, const state_type& to) noexcept {
+	return __builtin_ctzll(to.players[from.turn] ^ from.players[from.turn]); // the cell of the new piece
+}
+
+template<typename Board>
+bool basic_get_choices<Board>::play(const state_type& s, choice c, state_type& child) noexcept {
+	int cell = c >= 0 && c < Board::WIDTH && !s.end ? Board::drop(s.players[0] | s.players[1], c) : -1;
+	if(cell < 0){
+		return false;
+	}
+	child = s;
+	child.turn = !s.turn;
+	child.place(s.turn, cell);
+	child.end = child.fours[s.turn] != 0;
+	return true;
+}
 
-//const size_t get_choices::SEED(1473376696515541738L);
-//std::default_random_engine get_choices::random(get_choices::SEED);
+template<typename Board>
+uint64_t basic_get_choices<Board>::moves(const state_type& s) noexcept {
+	const uint64_t board = s.players[0] | s.players[1];
+	const uint64_t open = Board::playable(board);
+	const uint64_t wins = Board::winning_cells(s.players[s.turn]) & open;
+	if(wins){
+		return wins;
+	}
+	const uint64_t threats = Board::winning_cells(s.players[!s.turn]) & ~board;
+	uint64_t moves = open;
+	if(threats & open){ // with two every choice loses, the search still sees that
+		moves &= threats;
+	}
+	if(moves & ~(threats >> Board::WIDTH)){
+		moves &= ~(threats >> Board::WIDTH);
+	}
+	return moves;
+}
 
-const vector<pair<choice,state>> get_choices::operator()(const state& s) noexcept {
+template<typename Board>
+void basic_get_choices<Board>::operator()(const state_type& s, buffer& children) noexcept {
+	children.clear();
 	if(s.end){
-		return vector<pair<choice,state>>();
+		return;
 	}
-	vector<pair<choice,state>> children;
-	children.reserve(7);
-	state next(!s.turn, s.end, s.players[0], s.players[1]);
-	const uint64_t oldPieces = s.players[s.turn];
-	uint64_t& newPieces = next.players[s.turn];
 	const uint64_t board = s.players[0] | s.players[1];
-	for(int nextChoice = 0; nextChoice < 7; nextChoice++){
-		uint64_t shift = board >> nextChoice; // select the column choice corresponds to
-		int row = 0;
-		while(shift & 1){ // look for first open space in column
-			shift >>= 7;
-			row++;
+	const uint64_t allowed = moves(s);
+	array<int, Board::WIDTH> order = Board::CENTRE_FIRST;
+	if(randomize){ // add some randomness without giving up the centre first order
+		for(int pair = Board::WIDTH % 2; pair + 1 < Board::WIDTH; pair += 2){
+			if(random() & 1){
+				swap(order[pair], order[pair + 1]);
+			}
 		}
-		if(row > 5){
+	}
+	for(int nextChoice : order){
+		int cell = Board::drop(board, nextChoice);
+		if(cell < 0 || !(allowed >> cell & 1)){
 			continue;
 		}
-		newPieces = oldPieces | (uint64_t(1) << (nextChoice + row * 7)); // add new piece
-		if(check_winner(newPieces, row, nextChoice)){
+		auto &child = children.emplace_back(nextChoice, s);
+		state_type &next = child.second;
+		next.turn = !s.turn;
+		next.place(s.turn, cell); // add new piece
+		if(next.fours[s.turn]){ // place already counted the windows the new piece completes
 			next.end = true; // this is a winning child, ignore the other children
-			vector<pair<choice,state>> ret = {make_pair(nextChoice, next)};
-			return ret;
+			typename buffer::value_type win(child);
+			children.clear();
+			children.emplace_back(win);
+			return;
 		}
-		children.emplace_back(nextChoice, next);
-		next.end = false;
 	}
-	shuffle(children.begin(), children.end(), random); // add some randomness
-	return children;
 }
 
-void ais(size_t level){
+template<typename Board>
+const vector<pair<choice,basic_state<Board>>> basic_get_choices<Board>::operator()(const state_type& s){
+	buffer children;
+	(*this)(s, children);
+	return vector<pair<choice,state_type>>(children.begin(), children.end());
+}
+
+template<typename Board>
+milliseconds move_budget(const basic_game<Board>& g){
+	time_manager clock(milliseconds(g.settings.timebank), milliseconds(g.settings.time_per_move));
+	const basic_state<Board> s = g.minimax.state();
+	size_t empty = Board::CELLS - bit_count(s.players[0] | s.players[1]);
+	return clock.budget(milliseconds(g.timebank), (empty + 1) / 2);
+}
+
+bool known_move(game& g, choice& c){
+	return g.openings.lookup(g.minimax.state(), c) || g.endgame.lookup(g.minimax.state(), c);
+}
+
+template struct basic_state<board<6,5,4>>;
+template struct basic_state<board<7,6,4>>;
+template struct basic_state<board<8,7,4>>;
+template struct basic_state<board<9,7,4>>;
+template struct basic_heuristic<board<6,5,4>>;
+template struct basic_heuristic<board<7,6,4>>;
+template struct basic_heuristic<board<8,7,4>>;
+template struct basic_heuristic<board<9,7,4>>;
+template struct basic_get_choices<board<6,5,4>>;
+template struct basic_get_choices<board<7,6,4>>;
+template struct basic_get_choices<board<8,7,4>>;
+template struct basic_get_choices<board<9,7,4>>;
+template int evaluate(const basic_state<board<6,5,4>>&);
+template int evaluate(const basic_state<board<7,6,4>>&);
+template int evaluate(const basic_state<board<8,7,4>>&);
+template int evaluate(const basic_state<board<9,7,4>>&);
+template milliseconds move_budget(const basic_game<board<6,5,4>>&);
+template milliseconds move_budget(const basic_game<board<7,6,4>>&);
+template milliseconds move_budget(const basic_game<board<8,7,4>>&);
+template milliseconds move_budget(const basic_game<board<9,7,4>>&);
+
+void ais(size_t level, const book* openings){
 	minimax<score,state,choice,heuristic,get_choices> mm (state(0,false,0,0),MAX);
+	solver endgame;
 	bool turn = 0;
 	while(true){
 		state state;
 		string x;
-		mm.compute(level);
-		int choice = mm.choose(0);
+		int choice;
+		if((!openings || !openings->lookup(mm.state(), choice)) && !endgame.lookup(mm.state(), choice)){
+			mm.compute(level);
+			choice = mm.choose(0);
+		}
 		cout << (turn ? "o: " : "x: ") << choice << endl;
 		bool type = mm.type();
 		state = mm.progress(choice);
@@ -297,17 +492,20 @@ void ais(size_t level){
 	}
 }
 
-void hva(size_t level, bool humanFirst){
+void hva(size_t level, bool humanFirst, const book* openings){
 	state s = state(0,false,0,0);
 	minimax<score,state,int,heuristic,get_choices> mm (s, true);
+	solver endgame;
 	cout << s << endl;
 	string x;
 	int choice;
 	bool turn = true;
 	while(true){
 		if(!humanFirst){
-			mm.compute(level);
-			choice = mm.choose(0);
+			if((!openings || !openings->lookup(mm.state(), choice)) && !endgame.lookup(mm.state(), choice)){
+				mm.compute(level);
+				choice = mm.choose(0);
+			}
 			cout << (turn ? "o: " : "x: ") << choice << " score: " << mm.score() << endl;
 		//	minimax<score,state,int,heuristic,get_choices> mm2 (s, turn);
 		//	mm2.compute(level);
@@ -324,12 +522,13 @@ void hva(size_t level, bool humanFirst){
 				return;
 			}
 			turn = !turn;
+			mm.ponder(level); // the next compute starts from whatever this gets done while the human thinks
 		}
 		humanFirst = false;
 		do {
 			cout << (turn ? "o: " : "x: ");
 			cin >> choice;
-		} while(choice > 6 || choice < 0);
+		} while(choice >= WIDTH || choice < 0);
 		s = mm.progress(choice);
 		cout << s << endl;
 		if(abs(score_board(s)) > threshhold){
@@ -339,135 +538,3 @@ void hva(size_t level, bool humanFirst){
 		turn = !turn;
 	}
 }
-
-int main(int argc, char* argv[]){
-	char x;
-	size_t level;
-	cerr << "using seed: " << get_choices::SEED;
-	while(true) {
-		cout << "0 to spectate, 1 to go first, 2 to go second, q to quit: ";
-		cin >> x;
-		do {
-			cout << "difficulty (0-9): ";
-			cin >> level;
-		} while('0' <= level && level <= '9');
-		switch(x){
-		case '0': ais(level); break;
-		case '1': hva(level,true); break;
-		case '2': hva(level,false); break;
-		}
-	}
-}
-
-/*
-int main(int argc, char* argv[]){
-	ios_base::sync_with_stdio(false);
-	game g;
-	char buf[128];
-	bool turn = false;
-	buf[127] = '\0';
-	char *inserter = buf;
-	cerr << "USING SEED: " << get_choices::SEED << endl;
-	while(true){
-		g.minimax.compute(9);
-		if(g.action){
-			g.action = false;
-			choice c = g.minimax.choose(-1);
-			cout << "place_disc " << 6-c << endl << flush;
-			try {
-				g.minimax.progress(c);
-			} catch(const invalid_argument& e){
-				cerr << e.what() << endl;
-			}
-			cerr << "MY MOVE: " << c << ':' << g.minimax.score() << endl;
-			cerr << g.minimax.state() << endl << endl;
-		}
-		while(cin.readsome(inserter, 1) > 0){
-			if(*inserter != '\n'){
-				++inserter;
-				continue;
-			}
-			inserter = buf;
-			stringstream in;
-			string word;
-			in << buf;
-			in >> word;
-			if(word == "settings"){
-				in >> word;
-				if(word == "timebank") {
-					in >> g.settings.timebank;
-				} else if(word == "time_per_move") {
-					in >> g.settings.time_per_move;
-				} else if(word == "player_names") {
-
-				} else if(word == "your_bot") {
-					in >> g.settings.your_bot;
-				} else if(word == "your_botid") {
-					in >> g.settings.your_botid;
-				} else if("field_columns") {
-					in >> g.settings.field_columns;
-				} else if("field_rows") {
-					in >> g.settings.field_rows;
-				} else {
-					cerr << "bad setting: " << word << endl;
-				}
-			} else if(word == "update") {
-				in >> word;
-				if(word == "game") {
-					in >> word;
-					if(word == "round") {
-						in >> g.round;
-					} else if(word == "field"){
-						if(!turn){
-							uint64_t omove = 0;
-							string board;
-							in >> board;
-							for(int i = 0; i < 42; i++) {
-								int disc = board[2*i] - '0';
-								omove = (omove << 1) | (disc != 0 && disc != g.settings.your_botid);
-							}
-							uint64_t disc = omove ^ g.minimax.state().players[!(g.settings.your_botid-1)];
-							cerr << "DISC: " << bitset<42>(disc) << endl;
-							if(disc){ // disc is 0 for the start of the first round
-								uint64_t row = disc;
-								while(row >= (1 << 7)){
-									row >>= 7;
-								}
-								int choice = -1;
-								while(row){
-									row >>= 1;
-									choice++;
-								}
-								try {
-									g.minimax.progress(choice);
-								} catch(const invalid_argument& e){
-									cerr << e.what() << endl;
-								}
-								cerr << "THEIR MOVE: " << choice << ':' << g.minimax.score() << endl;
-								cerr << g.minimax.state() << endl << endl;
-							}
-						}
-						turn = !turn;
-					} else {
-						cerr << "bad update game: " << word << endl;
-					}
-				} else {
-					cerr << "bad update: " << word << endl;
-				}
-			} else if(word == "action"){
-				in >> word;
-				if(word == "move") {
-					unsigned long addedTime;
-					g.action = true;
-					in >> addedTime;
-					g.timebank = addedTime;
-				} else {
-					cerr << "bad action: " << word << endl;
-				}
-			} else {
-				cerr << "bad command: " << word << endl;
-			}
-		}
-	}
-}
-*/
@@ -9,10 +9,16 @@
 #define CONNECT4_H_
 
 #include <vector>
+#include <array>
+#include <random>
 #include <cstdint>
 #include <chrono>
 #include <iostream>
 #include "Minimax.hpp"
+#include "TimeManager.hpp"
+#include "Book.h"
+#include "Solver.h"
+#include "Board.h"
 
 class Board;
 struct Game;
@@ -21,41 +27,173 @@ struct Settings;
 using choice = int;
 using score = int;
 
-struct state {
+/**
+ * A position on Board. state, heuristic and get_choices are the standard board's, the bot plays every board in
+ * boards and each is instantiated once in Connect4.cpp.
+ */
+template<typename Board>
+struct basic_state {
+	using board_type = Board;
 	bool turn;
 	bool end;
+	std::array<uint8_t,2> fours; // complete windows of each player
+	int32_t eval; // sum of the open windows' scores for players[0], see score_board
 	std::array<uint64_t,2> players;
-	state() { }
-	state(bool turnA, bool endA, uint64_t player1, uint64_t player2) : turn(turnA), end(endA) {
+	uint64_t key; // the zobrist keys of every disc xored together, std::hash adds whose turn it is
+	basic_state() { }
+	basic_state(bool turnA, bool endA, uint64_t player1, uint64_t player2) : turn(turnA), end(endA) {
 		players[0] = player1;
 		players[1] = player2;
+		rescore();
 	}
-	state(const state& board) : turn(board.turn), end(board.end), players(board.players) { }
+
+	/**
+	 * drops a disc for player into the cell at bit index cell, only the windows through the cell are rescored and
+	 * the disc's key is xored into key
+	 */
+	void place(bool player, int cell) noexcept;
+
+	/**
+	 * recomputes eval and fours from every window and key from every disc
+	 */
+	void rescore() noexcept;
 };
+using state = basic_state<geometry>;
+extern template struct basic_state<board<6,5,4>>;
+extern template struct basic_state<board<7,6,4>>;
+extern template struct basic_state<board<8,7,4>>;
+extern template struct basic_state<board<9,7,4>>;
+
+constexpr uint64_t TURN_KEY = 0x85ebca6b85ebca6bull; // the zobrist key of players[1] to move, its own rotation
+
+/* the rotation of a zobrist hash by half a word, which is the hash of the board's mirror */
+constexpr uint64_t rotate_key(uint64_t key) noexcept {
+	return key << 32 | key >> 32;
+}
 
 namespace std {
 
-	template<>
-	struct hash<const state> {
-		size_t operator()(const state& state) const noexcept;
+	template<typename Board>
+	struct hash<const basic_state<Board>> {
+		size_t operator()(const basic_state<Board>& state) const noexcept {
+			return state.key ^ (state.turn ? TURN_KEY : 0);
+		}
 	};
 }
 
-bool operator==(const state&, const state&);
+template<typename Board>
+bool operator==(const basic_state<Board>& s1, const basic_state<Board>& s2){
+	return s1.turn == s2.turn && s1.players == s2.players;
+}
+
+template<typename Board>
+std::ostream& operator<<(std::ostream& os, const basic_state<Board>& s){
+	Board::print(os, s.players[0], s.players[1]);
+	return os;
+}
+
+constexpr int infinity = 20000; // a won board scores infinity less the loser's discs for players[0]
+constexpr int threshhold = infinity / 2; // scores past it are won or lost
 
+unsigned int bit_count(uint64_t x);
 
-std::ostream& operator<<(std::ostream& os, const state& state);
+/**
+ * scores every window of the board for players[0]. scan_board tests the windows one at a time, shift_board counts
+ * every window of a direction at once with whole board shifts and score_board is the one CONNECT4_SHIFT_EVAL picks,
+ * evaluate gives the same result from a state's running totals
+ */
+int score_board(const state& board);
+int scan_board(const state& board);
+int shift_board(const state& board);
+template<typename Board>
+int evaluate(const basic_state<Board>& board);
+
+/**
+ * whether board holds four in a row, scan_winner only looks at windows through the disc at row and col
+ */
+bool check_winner(uint64_t board, int row, int col);
+bool scan_winner(uint64_t board, int row, int col);
+bool shift_winner(uint64_t board);
 
-struct heuristic {
-	score operator()(const state&) const noexcept;
+template<typename Board>
+struct basic_heuristic {
+	score operator()(const basic_state<Board>&) const noexcept;
+
+	/**
+	 * evaluate for count states at once, without branches so the compiler can score several in each vector instruction
+	 */
+	void operator()(const basic_state<Board>* states, score* scores, size_t count) const noexcept;
 };
+using heuristic = basic_heuristic<geometry>;
+extern template struct basic_heuristic<board<6,5,4>>;
+extern template struct basic_heuristic<board<7,6,4>>;
+extern template struct basic_heuristic<board<8,7,4>>;
+extern template struct basic_heuristic<board<9,7,4>>;
+
+/**
+ * the move randomization of every board's get_choices, one seed makes every board's runs reproducible
+ */
+struct choice_random {
+	static thread_local std::default_random_engine random; // one per search thread, seeded from SEED when the thread first uses it
+	static size_t SEED; // from the clock unless seed is called
+	static bool randomize;
+
+	/**
+	 * reseeds the calling thread's engine and every engine created after it, for reproducible runs
+	 */
+	static void seed(size_t value);
 
-struct get_choices {
-	const std::vector<std::pair<choice,state>> operator()(const state& state) noexcept;
-	static std::default_random_engine random;
-	static const size_t SEED;
+	/**
+	 * reseeds only the calling thread's engine, for threads that each play games of their own
+	 */
+	static void seed_thread(size_t value) noexcept;
 };
 
+/**
+ * Children come centre column first, columns the same distance from the centre are swapped at random
+ * when randomize is set so equal lines don't always resolve the same way. Only the choices moves allows are
+ * made, play makes any legal one.
+ */
+template<typename Board>
+struct basic_get_choices : choice_random {
+	using state_type = basic_state<Board>;
+	static constexpr size_t MAX_CHOICES = Board::WIDTH;
+	using buffer = dhlib::minimax::choice_buffer<choice, state_type, MAX_CHOICES>;
+
+	void operator()(const state_type& s, buffer& children) noexcept; // what the search uses
+	const std::vector<std::pair<choice,state_type>> operator()(const state_type& s);
+	static constexpr size_t KEYS = Board::CELLS; // the search keeps move history per cell
+	static size_t key(const state_type& from, const choice& c, const state_type& to) noexcept;
+
+	/**
+	 * child is s with a disc dropped in column c as operator() makes it, false if c is full or the game is over
+	 */
+	static bool play(const state_type& s, choice c, state_type& child) noexcept;
+
+	/**
+	 * the cells worth playing: a win if there is one, else blocks of the opponent's wins, never the cell under one
+	 * of their wins unless every choice is, as playing there lets them win on top
+	 */
+	static uint64_t moves(const state_type& s) noexcept;
+	static constexpr bool SYMMETRIC = true; // a board and its reflection share table entries and tree nodes
+
+	/**
+	 * the board reflected left to right, every row's bits reversed at once, and the column a choice reflects to
+	 */
+	static state_type mirror(const state_type& s) noexcept;
+	static choice mirror(choice c) noexcept {
+		return Board::WIDTH - 1 - c;
+	}
+	static uint64_t mirror_hash(const state_type& s) noexcept {
+		return rotate_key(std::hash<const state_type>()(s));
+	}
+};
+using get_choices = basic_get_choices<geometry>;
+extern template struct basic_get_choices<board<6,5,4>>;
+extern template struct basic_get_choices<board<7,6,4>>;
+extern template struct basic_get_choices<board<8,7,4>>;
+extern template struct basic_get_choices<board<9,7,4>>;
+
 struct Settings {
 	unsigned long timebank;
 	unsigned long time_per_move;
@@ -67,15 +205,55 @@ struct Settings {
 };
 
 template class dhlib::minimax::minimax<score,state,choice,heuristic,get_choices>;
+template class dhlib::minimax::minimax<score,state,choice,heuristic,get_choices,dhlib::minimax::collect_stats>;
 
-struct game {
+/**
+ * what the bot keeps of a game on Board
+ */
+template<typename Board>
+struct basic_game {
+	using board_type = Board;
 	short round;
 	unsigned long timebank;
-	bool action;
 	Settings settings;
-	dhlib::minimax::minimax<score,state,choice,heuristic,get_choices> minimax;
-	game() : round(0), timebank(0), action(false), minimax(state(0,false,0,0),dhlib::minimax::MAX) {}
+	dhlib::minimax::minimax<score,basic_state<Board>,choice,basic_heuristic<Board>,basic_get_choices<Board>,dhlib::minimax::collect_stats> minimax; // the bot logs every search
+	basic_game() : round(0), timebank(0), minimax(basic_state<Board>(0,false,0,0),dhlib::minimax::MAX) {}
+};
+
+/**
+ * a game on the standard board, the only one with an opening book and an endgame solver
+ */
+struct game : basic_game<geometry> {
+	book openings; // empty unless a book was opened
+	solver endgame; // plays every move once the board is full enough to solve
 };
 
+/**
+ * the move the book or the solver has for the game's position, the other boards have neither
+ */
+template<typename Board>
+bool known_move(basic_game<Board>&, choice&) noexcept {
+	return false;
+}
+bool known_move(game& g, choice& c);
+
+/**
+ * plays level deep AIs against each other on stdout, positions in openings are played from the book and
+ * positions with solver::THRESHOLD discs are solved
+ */
+void ais(size_t level, const book* openings = nullptr);
+
+/**
+ * plays a level deep AI against moves read from stdin, positions in openings are played from the book and
+ * positions with solver::THRESHOLD discs are solved
+ */
+void hva(size_t level, bool humanFirst, const book* openings = nullptr);
+
+/**
+ * time to search for the next move, from the bank the last action move reported
+ */
+template<typename Board>
+std::chrono::milliseconds move_budget(const basic_game<Board>& g);
+
 
 #endif /* CONNECT4_H_ */
@@ -0,0 +1,46 @@
+/*
+ * Main.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include "Connect4.h"
+#include "Bot.h"
+
+using namespace std;
+using namespace dhlib::minimax;
+using namespace std::chrono;
+
+/**
+ * usage: connect4 [book] to play in the terminal, connect4 bot [book] [snapshot] to play the competition protocol
+ * on stdin and stdout, logging to stderr
+ */
+int main(int argc, char* argv[]){
+	if(argc > 1 && string(argv[1]) == "bot"){
+		ios_base::sync_with_stdio(false);
+		cerr << "USING SEED: " << get_choices::SEED << endl;
+		return run_bot(cin, cout, cerr, argc > 2 ? argv[2] : "", argc > 3 ? argv[3] : "") ? 0 : 1;
+	}
+	char x;
+	size_t level;
+	book openings;
+	if(argc > 1 && !openings.open(argv[1])){
+		cerr << "not an opening book: " << argv[1] << endl;
+	}
+	cerr << "using seed: " << get_choices::SEED;
+	while(true) {
+		cout << "0 to spectate, 1 to go first, 2 to go second, q to quit: ";
+		cin >> x;
+		do {
+			cout << "difficulty (0-9): ";
+			cin >> level;
+		} while('0' <= level && level <= '9');
+		switch(x){
+		case '0': ais(level, &openings); break;
+		case '1': hva(level, true, &openings); break;
+		case '2': hva(level, false, &openings); break;
+		}
+	}
+}
+
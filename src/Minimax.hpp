@@ -10,13 +10,22 @@
 
 #include <memory>
 #include <algorithm>
-#include <unordered_map>
+#include <functional>
 #include <iostream>
 #include <set>
 #include <vector>
 #include <deque>
 #include <limits>
 #include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include "Transposition.hpp"
+#include "Search.hpp"
+#include "Choices.hpp"
+#include "Stats.hpp"
 
 namespace dhlib { namespace minimax {
 
@@ -24,6 +33,118 @@ namespace dhlib { namespace minimax {
 	constexpr bool MIN = false;
 
 	namespace details {
+		/**
+		 * Slab allocator for tree nodes, slabs are never moved so a node's address is stable until it is freed.
+		 * Freed slots are threaded onto an intrusive free list and reused by later allocations.
+		 */
+		template<typename Node>
+		class node_pool {
+		public:
+			static constexpr std::size_t SLAB_BITS = 12;
+			static constexpr std::size_t SLAB_SIZE = std::size_t(1) << SLAB_BITS;
+
+			node_pool() noexcept : used_(0), size_(0), free_(null_handle) { }
+			node_pool(const node_pool&) = delete;
+			node_pool& operator=(const node_pool&) = delete;
+			~node_pool() {
+				clear();
+			}
+
+			template<typename... Args>
+			handle allocate(Args&&... args) {
+				handle h = free_;
+				if(h != null_handle){
+					free_ = next(h);
+				} else {
+					if(used_ == null_handle){
+						throw std::length_error("node pool exhausted");
+					}
+					if(used_ == slabs_.size() * SLAB_SIZE){
+						slabs_.emplace_back(new slot[SLAB_SIZE]);
+					}
+					h = used_++;
+				}
+				slot &s = at(h);
+				new (s.storage) Node(std::forward<Args>(args)...);
+				s.live = true;
+				++size_;
+				return h;
+			}
+
+			void free(handle h) noexcept {
+				slot &s = at(h);
+				reinterpret_cast<Node*>(s.storage)->~Node();
+				s.live = false;
+				next(h) = free_;
+				free_ = h;
+				--size_;
+			}
+
+			/**
+			 * frees every node that keep returns false for
+			 */
+			template<typename Keep>
+			void sweep(Keep keep) noexcept {
+				for(handle h = 0; h < used_; ++h){
+					if(at(h).live && !keep(h, (*this)[h])){
+						free(h);
+					}
+				}
+			}
+
+			void clear() noexcept {
+				sweep([](handle, Node&){ return false; });
+				slabs_.clear();
+				used_ = 0;
+				free_ = null_handle;
+			}
+
+			Node& operator[](handle h) noexcept {
+				return *reinterpret_cast<Node*>(at(h).storage);
+			}
+			const Node& operator[](handle h) const noexcept {
+				return *reinterpret_cast<const Node*>(at(h).storage);
+			}
+			bool live(handle h) const noexcept {
+				return h < used_ && at(h).live;
+			}
+			std::size_t size() const noexcept {
+				return size_;
+			}
+			std::size_t capacity() const noexcept {
+				return slabs_.size() * SLAB_SIZE;
+			}
+		private:
+			struct slot {
+				alignas(Node) unsigned char storage[sizeof(Node)];
+				bool live = false;
+			};
+			static_assert(sizeof(Node) >= sizeof(handle), "free list link is stored in the node storage");
+
+			slot& at(handle h) noexcept {
+				return slabs_[h >> SLAB_BITS][h & (SLAB_SIZE - 1)];
+			}
+			const slot& at(handle h) const noexcept {
+				return slabs_[h >> SLAB_BITS][h & (SLAB_SIZE - 1)];
+			}
+			handle& next(handle h) noexcept {
+				return *reinterpret_cast<handle*>(at(h).storage);
+			}
+
+			std::vector<std::unique_ptr<slot[]>> slabs_;
+			handle used_; // slots handed out from the slabs so far, free or not
+			std::size_t size_; // live nodes
+			handle free_;
+		};
+
+		/* whether Heuristic can also score count states into scores with one call */
+		template<typename Heuristic, typename State, typename Score, typename = void>
+		struct batched : std::false_type { };
+		template<typename Heuristic, typename State, typename Score>
+		struct batched<Heuristic, State, Score, std::void_t<decltype(
+			std::declval<const Heuristic&>()(std::declval<const State*>(), std::declval<Score*>(), std::size_t())
+		)>> : std::true_type { };
+
 		/**
 		 * indicates a position in the tree
 		 */
@@ -31,19 +152,18 @@ namespace dhlib { namespace minimax {
 		class Marker {
 		public:
 			using Node = typename Minimax::node;
-			Marker(Minimax& mm) noexcept {
+			using Pool = typename Minimax::pool_type;
+			Marker(Minimax& mm) noexcept : pool_(&mm.pool) {
 				path_.emplace_back(mm.root);
 			}
 
-			void progress(const Node& newRoot) noexcept {
+			void progress(handle newRoot) noexcept {
 				while(path_.size()){
-					std::weak_ptr<Node> &front = path_.front();
-					if(front.expired()){
+					if(!pool_->live(path_.front())){
 						path_.pop_front();
 						continue;
 					}
-					std::shared_ptr<Node> next = path_.front().lock();
-					if(&newRoot == next.get()){
+					if(newRoot == path_.front()){
 						return;
 					}
 					path_.pop_front();
@@ -51,7 +171,7 @@ namespace dhlib { namespace minimax {
 			}
 			bool expired() const noexcept {
 				while(path_.size()){
-					if(path_.front().expired()){
+					if(!pool_->live(path_.front())){
 						path_.pop_front();
 					} else {
 						return false;
@@ -59,17 +179,18 @@ namespace dhlib { namespace minimax {
 				}
 				return true;
 			}
-			std::weak_ptr<Node> node() const noexcept {
+			handle node() const noexcept {
 				if(path_.size()){
 					return path_.back();
 				}
-				return std::weak_ptr<Node>();
+				return null_handle;
 			}
-			std::deque<std::weak_ptr<Node>>& path() const noexcept {
+			std::deque<handle>& path() const noexcept {
 				return path_;
 			}
 		private:
-			mutable std::deque<std::weak_ptr<Node>> path_;
+			const Pool* pool_;
+			mutable std::deque<handle> path_;
 		};
 	}
 
@@ -79,123 +200,273 @@ namespace dhlib { namespace minimax {
 	 *	State: A representation of the game state that is stored on each minimax node, requires
 	 *		std::hash<State>
 	 *		operator==(State,State).
+	 *	GetChoices: returns a container of (Choice, State) children, or with a MAX_CHOICES member fills the
+	 *		choice_buffer<Choice, State, MAX_CHOICES> it is passed and nodes keep their children in arrays that
+	 *		large, so expanding a node allocates nothing. With SYMMETRIC set and static mirror(State) and
+	 *		mirror(Choice) a position and its reflection share table entries and tree nodes, choose, progress and
+	 *		state still use the orientation played. A static mirror_hash(State) gives the hash of the mirror
+	 *		without building it. GetChoices may leave out choices
+	 *		that can't be better than the others, a static bool play(State, Choice, State& child) making any legal
+	 *		choice's child lets progress follow those when they are played.
+	 *	Heuristic: scores a State, with an operator()(const State*, Score*, size_t) as well the tree scores the new
+	 *		children of a node together when they are the search's leaves
+	 *	Stats: no_stats, or collect_stats to have every search fill in stats()
 	 */
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats = no_stats>
 	class minimax {
 	public:
 		class node {
 		public:
 			using NodeScore = Score;
-			bool mark;
+			using Pool = details::node_pool<node>;
+			std::uint32_t refs; // children lists holding this node, plus one for the root
+			bool pending; // waiting in the release list
+			bool evaluated; // score was set by a batch before the search reached this leaf
 			State state;
 			Score score; // this node's score calculated from its children or from the heuristic
 			size_t height; // distance to closest child leaf
-			std::vector<std::shared_ptr<node>> children;
-			std::vector<Choice> choices;
+			details::node_list<handle, GetChoices> children; // inline when GetChoices has MAX_CHOICES, expanding allocates nothing
+			details::node_list<Choice, GetChoices> choices;
 			node();
 			node(const minimax& minimaxA, State stateA, bool type) :
-				mark(false), state(stateA),
+				refs(0), pending(false), evaluated(false), state(stateA),
 				score(type ? std::numeric_limits<Score>::min() : std::numeric_limits<Score>::max()),
 				height(0) { }
 
-			std::ostream& print(std::ostream& out) const {
+			std::ostream& print(std::ostream& out, const Pool& pool) const {
 				out << "(" << score << ':' << height << ' ';
 				for(auto iter = children.begin(); iter != children.end(); ++iter){
 					out << ' ' << choices[iter-children.begin()] << ':';
-					(*iter)->print(out);
+					pool[*iter].print(out, pool);
 				}
 				return out << ")";
 			}
-			void printChildren(size_t depth){
+			void printChildren(size_t depth, const Pool& pool) const {
 				std::cout << "score:" << score << ":" << height;
 				if(depth == 0){
 					return;
 				}
-				for(auto &child : children) {
-					child->printChildren(depth-1);
+				for(handle child : children) {
+					pool[child].printChildren(depth-1, pool);
 				}
 				std::cout << std::endl;
 			}
-			void verifyNode(bool type) {
+			void verifyNode(bool type, const Pool& pool) const {
 				Score best = type ? std::numeric_limits<Score>::min() : std::numeric_limits<Score>::max();
-				for(std::shared_ptr<node> &child : children){
+				for(handle h : children){
+					const node &child = pool[h];
 					if(type){
-						best = std::max(best, child->score);
-						assert(child->score <= score);
+						best = std::max(best, child.score);
+						assert(child.score <= score);
 					} else {
-						best = std::min(best, child->score);
-						assert(child->score >= score);
+						best = std::min(best, child.score);
+						assert(child.score >= score);
 					}
 				}
 				if(children.size()){
 					assert(score == best);
 				} else {
-					Heuristic h;
-					assert(score == h(state));
+					assert(score == Heuristic()(state));
 				}
 				size_t infinity = std::numeric_limits<size_t>::max();
 				bool allInf = true;
-				for(std::shared_ptr<node> &child : children){
-					if(child->score == best){
-						assert(child->height == infinity || child->height+1 == height);
-						if(child->height != infinity) {
+				for(handle h : children){
+					const node &child = pool[h];
+					if(child.score == best){
+						assert(child.height == infinity || child.height+1 == height);
+						if(child.height != infinity) {
 							allInf = false;
 						}
 					}
 				}
 				assert(height != infinity || allInf);
-				for(std::shared_ptr<node> &child : children){
-					if(child->score == best){ // pruned nodes won't have their values calculated
-						child->verifyNode(!type);
+				(void)allInf; // only the asserts read it
+				for(handle h : children){
+					const node &child = pool[h];
+					if(child.score == best){ // pruned nodes won't have their values calculated
+						child.verifyNode(!type, pool);
 					}
 				}
 			}
 		};
 
-		using node_ptr = std::shared_ptr<node>;
-		using const_ptr = std::shared_ptr<const node>;
-		using weak_ptr = std::weak_ptr<node>;
-		using const_weak_ptr = std::weak_ptr<const node>;
-		using child_iter = typename std::vector<node_ptr>::iterator;
-		using const_child_iter = typename std::vector<node_ptr>::const_iterator;
-		using marker = details::Marker<minimax<Score,State,Choice,Heuristic, GetChoices>>;
-		using const_marker = details::Marker<const minimax<Score,State,Choice,Heuristic, GetChoices>>;
+		using pool_type = details::node_pool<node>;
+		using child_iter = typename details::node_list<handle, GetChoices>::iterator;
+		using const_child_iter = typename details::node_list<handle, GetChoices>::const_iterator;
+		using marker = details::Marker<minimax<Score,State,Choice,Heuristic,GetChoices,Stats>>;
+		using const_marker = details::Marker<const minimax<Score,State,Choice,Heuristic,GetChoices,Stats>>;
+
+		using table_type = transposition_table<Score, Choice>;
+		using score_type = Score;
+		using state_type = State;
+		using choice_type = Choice;
+		using heuristic_type = Heuristic;
+		using choices_type = GetChoices;
 
-		std::unordered_map<const State, std::weak_ptr<node>> nodes;
-		node_ptr root;
+		pool_type pool;
+		table_type table;
+		handle root;
 
-		minimax(const State& start, bool isMax) noexcept : root(new node(*this, start, isMax)), type_(isMax) {}
+		/**
+		 * tableBytes is the memory budget of the transposition table
+		 */
+		minimax(const State& start, bool isMax, std::size_t tableBytes = table_type::DEFAULT_BYTES) :
+			pool(), table(tableBytes), root(pool.allocate(*this, start, isMax)), type_(isMax), timed_(false), checks_(0), threads_(0), algorithm_(search_algorithm::tree), aspiration_(0), centres_{std::numeric_limits<Score>::min(), std::numeric_limits<Score>::min()}, nodes_(0), researches_(0), mirrored_(false), stop_(false), cancel_(false), ponderScore_() {
+			pool[root].refs = 1;
+			table.link(hash(start), root);
+		}
+		~minimax() {
+			stop_pondering();
+		}
+		minimax(const minimax&) = delete;
+		minimax& operator=(const minimax&) = delete;
 
 		/**
 		 * Sets the root's child with the specified choice as the root, it also negates the tree type,
-		 * throws invalid argument if choice is not allowed for the root's state
+		 * throws invalid argument if choice is not allowed for the root's state. The old root is released in
+		 * constant time, the nodes only it reached are returned to the pool by later searches.
 		 */
-		const State& progress(const Choice& choice);
+		State progress(const Choice& choice);
 
 		/**
 		 * Provides the best calculated move
 		 */
-		const Choice& choose(const Choice& def) const noexcept;
+		Choice choose(const Choice& def) const noexcept;
 
 		/**
 		 * Traverses nodes below the specified marker, using the heuristic to calculate leaf values,
 		 * uses a/b pruning, continues until node at marker has specified height, if no node is specified,
-		 * the root is used
+		 * the root is used. Returns false if the deadline of compute_for cut the search short, the
+		 * start node and its children then keep the values they had before the call.
 		 */
 		void compute(std::size_t height) noexcept;
-		void compute(size_t height, const marker& start);
+		bool compute(size_t height, const marker& start);
+
+		/**
+		 * Deepens the root one ply at a time until budget runs out or maxHeight is reached, the best choice of
+		 * every iteration is searched first by the next one. An iteration that would overrun the budget is
+		 * abandoned and rolled back, returns the root's height afterwards.
+		 */
+		std::size_t compute_for(std::chrono::milliseconds budget, std::size_t maxHeight = std::numeric_limits<std::size_t>::max());
+
+		/**
+		 * With a thread count compute and compute_for search the root with Lazy SMP: every thread runs its own
+		 * iterative deepening alpha-beta and they cooperate only through the transposition table, helpers start
+		 * at alternating depths and root orders so they fill in what the main thread needs next. The main
+		 * thread's result is written to the root and its children. 0, the default, searches the tree on the
+		 * calling thread.
+		 */
+		void threads(unsigned count) noexcept {
+			threads_ = count;
+		}
+		unsigned threads() const noexcept {
+			return threads_;
+		}
+
+		/**
+		 * Any algorithm but tree searches the root like a single threaded Lazy SMP search, the tree is only
+		 * used to hold the root's children. PVS and MTD(f) rely on the transposition table keeping bounds.
+		 */
+		void algorithm(search_algorithm algorithm) noexcept {
+			algorithm_ = algorithm;
+		}
+		search_algorithm algorithm() const noexcept {
+			return algorithm_;
+		}
+
+		/**
+		 * With a window above 0 the tree, alphabeta and PVS search the root between the last score less and plus
+		 * window and widen the side that fails by twice as much each time until the score lands inside. progress
+		 * hands the scores of the old root's searches on to the new root, so the first search after it has a window
+		 * too. 0, the default, searches every root with the full window. MTD(f) has its own windows, and searches
+		 * from a marker other than the root always use the full window. stats() counts the failures.
+		 */
+		void aspiration(Score window) noexcept {
+			aspiration_ = window;
+		}
+		Score aspiration() const noexcept {
+			return aspiration_;
+		}
 
 		/**
-		 * Uses mark and sweep to remove separated node cycles, doesn't need to be used if cycles can't occur.
+		 * how often searches since the last reset_cutoffs ended a node early on its first child, parallel
+		 * searches count the main thread only
 		 */
-		void collect_garbage() noexcept;
+		const cutoff_stats& cutoffs() const noexcept {
+			return order_.stats;
+		}
+		void reset_cutoffs() noexcept {
+			order_.stats = cutoff_stats();
+		}
+
+		/**
+		 * nodes visited by every thread of the last parallel search
+		 */
+		std::size_t nodes() const noexcept {
+			return nodes_;
+		}
+
+		/**
+		 * what the last compute, compute_for or ponder did, all zero unless Stats is collect_stats
+		 */
+		const search_stats& stats() const noexcept {
+			return stats_;
+		}
+
+		/**
+		 * hook is called with stats() whenever a compute, compute_for or ponder finishes, on the thread that ran it,
+		 * never with no_stats
+		 */
+		void on_search(std::function<void(const search_stats&)> hook) {
+			hook_ = std::move(hook);
+		}
+
+		/**
+		 * searches of the last parallel search that had to be repeated with another window, see searcher::researches
+		 */
+		std::size_t researches() const noexcept {
+			return researches_;
+		}
+
+		/**
+		 * Keeps deepening the root on a background thread until maxHeight, a solved root or stop_pondering.
+		 * Meant for the opponent's time: the next progress stops it and keeps whatever it searched below
+		 * the move actually played. Until then only progress, stop_pondering, pondering, state, score and type
+		 * may be called, the last three give the root as it was when ponder started. compute and compute_for stop
+		 * it before they search.
+		 */
+		void ponder(std::size_t maxHeight = std::numeric_limits<std::size_t>::max());
+
+		/**
+		 * Stops a search started by ponder and waits for it, an unfinished iteration is rolled back.
+		 */
+		void stop_pondering() noexcept;
+		bool pondering() const noexcept {
+			return ponderer_.joinable();
+		}
+
+		/**
+		 * Frees every node released so far, at a cost proportional to the nodes freed. Nodes are counted by the
+		 * children lists holding them, progress releases the old root and searches free released nodes as they
+		 * go, so this is only needed to return everything at once.
+		 */
+		void collect_garbage() noexcept {
+			reclaim(std::numeric_limits<size_t>::max());
+		}
+
+		/**
+		 * nodes released but not yet freed
+		 */
+		std::size_t garbage() const noexcept {
+			return pending_.size();
+		}
 
 		std::ostream& print(std::ostream& os) const;
 
 		const Score& score() const noexcept {
-			return root->score;
+			return pondering() ? ponderScore_ : pool[root].score;
 		}
-		const State& state() const noexcept;
+		State state() const noexcept;
 
 		bool type() const noexcept {
 			return type_;
@@ -203,95 +474,250 @@ namespace dhlib { namespace minimax {
 
 		void verify();
 	private:
-		bool type_;
-	};
+		using clock = std::chrono::steady_clock;
 
-	template<typename Node>
-	static bool is_good(const std::weak_ptr<Node>& ptr){
-		return !ptr.expired();
-	}
+		static std::uint64_t hash(const State& state) noexcept {
+			bool mirrored;
+			return details::canonical_hash<GetChoices>(state, mirrored);
+		}
 
-	template<typename Node>
-	static bool is_bad(const std::weak_ptr<Node>& ptr){
-		return ptr.expired();
-	}
+		/* the node holding state, or its mirror, if the table still links to one */
+		handle find(std::uint64_t key, const State& state) const noexcept {
+			typename table_type::entry entry;
+			if(table.probe(key, entry) && entry.node != null_handle && pool.live(entry.node) && details::equivalent<GetChoices>(pool[entry.node].state, state)){
+				return entry.node;
+			}
+			return null_handle;
+		}
 
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
-	void minimax<Score,State,Choice,Heuristic,GetChoices>::collect_garbage() noexcept {
-		std::vector<std::pair<child_iter, child_iter>> path;
-		root->mark = true;
-		path.emplace_back(root->children.begin(), root->children.end());
-		while(path.size() > 0){
-			std::pair<child_iter,child_iter>& range = path.back();
-			child_iter &begin = range.first, &end = range.second;
-			if(begin == end){
-				path.pop_back();
-			} else {
-				node_ptr &child = *begin;
-				if(!child->mark) {
-					child->mark = true;
-					path.emplace_back(child->children.begin(), child->children.end());
+		using searcher = details::searcher<Score, State, Choice, Heuristic, GetChoices>;
+		using order_type = typename searcher::order_type;
+
+		/* Lazy SMP search of the root, returns the deepest height the main thread completed */
+		size_t search_parallel(size_t maxHeight, clock::time_point deadline);
+
+		/* searches every child of the root to height-1, best first, returns false if stopped */
+		bool search_root(searcher& s, size_t height, size_t offset, std::vector<size_t>& order, std::vector<Score>& values, Score& guess, Score (&centres)[2]);
+
+		/* searches the root to height in the tree inside the aspiration window, returns false if the deadline cut it short */
+		bool search_tree(size_t height);
+
+		/* compute(height, start) with the start node's score starting at lower for MAX and upper for MIN, and its
+		 * search ending once its score reaches the other bound */
+		bool compute(size_t height, const marker& start, Score lower, Score upper);
+
+		/* whether compute goes through the table searchers rather than the tree */
+		bool table_search() const noexcept {
+			return threads_ || algorithm_ != search_algorithm::tree;
+		}
+
+		/* moves the best child of every node along the principal variation to the front of its children */
+		void order_principal_variation() noexcept;
+
+		void begin_stats() noexcept {
+			if constexpr (Stats::enabled) {
+				stats_ = search_stats();
+				statsBegin_ = clock::now();
+			}
+		}
+		void end_stats() {
+			if constexpr (Stats::enabled) {
+				stats_.live = pool.size();
+				if(pool[root].height != std::numeric_limits<size_t>::max()){
+					stats_.depth = pool[root].height;
+				}
+				stats_.elapsed = clock::now() - statsBegin_;
+				if(hook_){
+					hook_(stats_);
 				}
-				++begin;
 			}
 		}
-		for(auto entry = nodes.begin(); entry != nodes.end(); ){
-			if(entry->second.expired()){
-				entry = nodes.erase(entry);
-			} else {
-				node_ptr node = entry->second.lock();
-				if(!node->mark) {
-					node->children.clear(); // delete the children pointers to remove the garbage
-					entry = nodes.erase(entry);
-				} else {
-					node->mark = false; // reset mark
-					++entry;
+
+		/* leaves the nodes a timed out compute was in the middle of consistent */
+		void abandon(node& startNode, const std::vector<std::pair<Score, size_t>>& saved, const std::vector<child_iter>& path);
+
+		/**
+		 * scores the children of parent that are leaves with one call to the heuristic, the search then takes their scores
+		 * as they are. The children are reordered best first for parentType so the first one visited settles the parent.
+		 */
+		void evaluate_leaves(const Heuristic& heuristic, node& parent, bool parentType) {
+			leafStates_.clear();
+			leafNodes_.clear();
+			for(handle h : parent.children){
+				const node& child = pool[h];
+				if(child.children.empty() && !child.evaluated){
+					leafStates_.push_back(child.state);
+					leafNodes_.push_back(h);
+				}
+			}
+			leafScores_.resize(leafStates_.size());
+			heuristic(leafStates_.data(), leafScores_.data(), leafStates_.size());
+			for(size_t i = 0; i < leafNodes_.size(); ++i){
+				node& leaf = pool[leafNodes_[i]];
+				leaf.score = leafScores_[i];
+				leaf.evaluated = true;
+			}
+			if constexpr (Stats::enabled) {
+				stats_.evaluated += leafNodes_.size();
+			}
+			for(size_t i = 1; i < parent.children.size(); ++i){ // stable, ties keep the order the move ordering gave them
+				size_t at = i;
+				const Score score = pool[parent.children[i]].score;
+				while(at && (parentType ? pool[parent.children[at - 1]].score < score : pool[parent.children[at - 1]].score > score)){
+					std::swap(parent.children[at - 1], parent.children[at]);
+					std::swap(parent.choices[at - 1], parent.choices[at]);
+					--at;
 				}
 			}
 		}
-	}
 
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
-	const State& minimax<Score,State,Choice,Heuristic,GetChoices>::progress(const Choice& choice) {
+		static constexpr size_t CHECK_INTERVAL = 1024; // leaves evaluated between deadline checks
+		static constexpr size_t RECLAIM_PER_NODE = 2; // released nodes freed for every node a search creates
+		static constexpr size_t RECLAIM_PER_SEARCH = 4096; // and at the start of every compute or compute_for
+
+		/* drops a reference to h, a node nothing refers to waits for reclaim, which can still find it through the table */
+		void release(handle h) {
+			node &n = pool[h];
+			if(--n.refs == 0 && !n.pending){
+				n.pending = true;
+				pending_.push_back(h);
+			}
+		}
+
+		/* frees up to budget released nodes, releasing their children in turn */
+		void reclaim(size_t budget) noexcept {
+			while(budget && pending_.size()){
+				handle h = pending_.back();
+				pending_.pop_back();
+				node &n = pool[h];
+				n.pending = false;
+				if(n.refs){ // linked again since it was released
+					continue;
+				}
+				for(handle child : n.children){
+					release(child);
+				}
+				pool.free(h); // table links to freed nodes are caught by find
+				--budget;
+			}
+		}
+
+		bool type_;
+		bool timed_;
+		size_t checks_;
+		clock::time_point deadline_;
+		unsigned threads_;
+		search_algorithm algorithm_;
+		Score aspiration_;
+		// heuristics that favour the side moving last swing between odd and even depths, so aspiration windows are
+		// centred on the root's last score of a search of the same parity, lowest while there is none
+		Score centres_[2];
+		std::size_t nodes_;
+		std::size_t researches_;
+		bool mirrored_; // the root holds the mirror of the position progress played to
+		std::atomic<bool> stop_; // stops the table searchers
+		std::atomic<bool> cancel_; // set by stop_pondering, ends the background search at its next check
+		std::thread ponderer_;
+		State ponderState_; // state() and score() while pondering, the background search is changing the pool
+		Score ponderScore_;
+		order_type order_; // killers and history of the tree search, the searchers keep their own
+		search_stats stats_;
+		clock::time_point statsBegin_;
+		std::function<void(const search_stats&)> hook_;
+		std::vector<handle> pending_; // released nodes, freed a few at a time
+		std::vector<State> leafStates_; // what evaluate_leaves hands the heuristic, kept to reuse the memory
+		std::vector<Score> leafScores_;
+		std::vector<handle> leafNodes_;
+	};
+
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	State minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::progress(const Choice& played) {
+		stop_pondering();
 		type_ = !type_;
-		if(root->children.empty()){
+		if(pool[root].children.empty()){
 			compute(1);
-			if(root->children.empty()){
+			if(pool[root].children.empty()){
 				throw std::logic_error("choice inconsistent with game state");
 			}
 		}
-		node_ptr newRoot;
+		const node &rootNode = pool[root];
+		const Choice choice = details::orient<GetChoices>(played, mirrored_);
+		handle newRoot = null_handle;
 		for(
-				auto childChoice = root->choices.begin(), child = root->children.begin();
-				childChoice != root->choices.end();
+				auto childChoice = rootNode.choices.begin(), child = rootNode.children.begin();
+				childChoice != rootNode.choices.end();
 				++childChoice, ++child
 		){
-			if(*childChoice == choice && !newRoot){
+			if(*childChoice == choice && newRoot == null_handle){
 				newRoot = *child;
 			}
 		}
-		if(!newRoot){
-			throw std::invalid_argument("invalid choice");
+		if(newRoot != null_handle){ // the old root's search to a height scores the new root a ply less deep
+			std::swap(centres_[0], centres_[1]);
+		} else {
+			centres_[0] = centres_[1] = std::numeric_limits<Score>::min();
 		}
-		root = newRoot; // this may trigger deletions of nodes referenced by mightDelete
-		for(auto entry = nodes.begin(); entry != nodes.end(); ){
-			if(entry->second.expired()){
-				entry = nodes.erase(entry);
-			} else {
-				++entry;
+		GetChoices getChoices;
+		if constexpr (details::symmetric<GetChoices>::value) {
+			if(newRoot != null_handle){ // the child may be shared with the mirrored line
+				for(auto &child : details::children_of<Choice>(getChoices, rootNode.state)){
+					if(child.first == choice && !(child.second == pool[newRoot].state)){
+						mirrored_ = !mirrored_;
+						break;
+					}
+				}
+			}
+		}
+		if(newRoot == null_handle){ // GetChoices may leave out moves, or the one played may be missing from the reflection
+			State child;
+			if(!details::play(getChoices, state(), played, child)){
+				throw std::invalid_argument("invalid choice");
+			}
+			std::uint64_t key = hash(child);
+			newRoot = find(key, child);
+			if(newRoot == null_handle){
+				newRoot = pool.allocate(*this, child, type_);
+				table.link(key, newRoot);
+			}
+			if constexpr (details::symmetric<GetChoices>::value) {
+				mirrored_ = !(pool[newRoot].state == child);
 			}
 		}
-		return newRoot->state;
+		handle oldRoot = root;
+		root = newRoot;
+		++pool[newRoot].refs;
+		release(oldRoot); // the rest of the old tree is freed by the searches that follow
+		table.new_search();
+		order_.age();
+		return state();
 	}
 
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
-	const State& minimax<Score,State,Choice,Heuristic,GetChoices>::state() const noexcept {
-		return root->state;
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	State minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::state() const noexcept {
+		if(pondering()){
+			return ponderState_;
+		}
+		if constexpr (details::symmetric<GetChoices>::value) {
+			if(mirrored_){
+				return GetChoices::mirror(pool[root].state);
+			}
+		}
+		return pool[root].state;
 	}
 
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
-	void minimax<Score,State,Choice,Heuristic,GetChoices>::compute(size_t depth) noexcept {
-		compute(depth, marker(*this));
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	void minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::compute(size_t depth) noexcept {
+		stop_pondering();
+		begin_stats();
+		reclaim(RECLAIM_PER_SEARCH);
+		if(table_search()){
+			if(pool[root].height < depth){
+				search_parallel(depth, clock::time_point::max());
+			}
+		} else {
+			search_tree(depth);
+		}
+		end_stats();
 	}
 
 	/* updates parent's score from child score based on parentType */
@@ -305,19 +731,19 @@ namespace dhlib { namespace minimax {
 	}
 
 	/* same as above, but returns true if we can apply pruning */
-	template<typename Node>
-	bool update_score(Node &child, Node &parent, Node &gParent, bool parentType){
+	template<typename Node, typename Pool>
+	bool update_score(Node &child, Node &parent, Node &gParent, bool parentType, Pool &pool){
 		if(parentType == MAX){
 			parent.score = std::max(parent.score, child.score);
 			if(parent.score > gParent.score){
-				if(&child != parent.children.back().get()) { // a parent that is pruned based on its last child isn't really pruned
+				if(&child != &pool[parent.children.back()]) { // a parent that is pruned based on its last child isn't really pruned
 					return true;
 				}
 			}
 		} else {
 			parent.score = std::min(parent.score, child.score);
 			if(parent.score < gParent.score){
-				if(&child != parent.children.back().get()) {
+				if(&child != &pool[parent.children.back()]) {
 					return true;
 				}
 			}
@@ -325,32 +751,36 @@ namespace dhlib { namespace minimax {
 		return false;
 	}
 
-	/* returns the next explorable node, this function skips explored nodes and applies pruning while upading parent score and height */
-	template<typename Node, typename Path>
-	Node& next_node(const size_t depth, Node &startNode, Path &path, bool &nodeType) noexcept {
+	/* returns the next explorable node, this function skips explored nodes and applies pruning while upading parent score and height,
+	 * onCutoff(parent, index of the child that pruned it, parent's ply, parentType) is called before a parent is pruned, the start
+	 * node's search ends once its score reaches stop */
+	template<typename Node, typename Path, typename Pool, typename OnCutoff>
+	Node& next_node(const size_t depth, Node &startNode, const typename Node::NodeScore &stop, Path &path, bool &nodeType, Pool &pool, OnCutoff &&onCutoff) noexcept {
 		constexpr size_t infinity = std::numeric_limits<size_t>::max();
 
 		// next child
 		while(path.size()) {
-			Node *parent = (path.size() >= 2) ? path[path.size() - 2]->get() : &startNode;
+			Node *parent = (path.size() >= 2) ? &pool[*path[path.size() - 2]] : &startNode;
 			bool parentType = !nodeType;
 
-			// iter is a pointer to an iterator over pointers in a nodes children vector, we use a pointer because we want
+			// iter is a pointer to an iterator over handles in a nodes children vector, we use a pointer because we want
 			// increments to iter to mutate path.back(), we do not use a reference because we may change iter if pruning occurs
 			auto *iter = &path.back();
 			while(*iter != parent->children.end()) { // check for next sibling
-				size_t childHeight = (**iter)->height;
+				size_t childHeight = pool[**iter].height;
 				if(path.size() >= 2){
-					Node &gParent = path.size() >= 3 ? **path[path.size()-3] : startNode;
-					if(update_score(***iter, *parent, gParent, parentType)){
+					Node &gParent = path.size() >= 3 ? pool[*path[path.size()-3]] : startNode;
+					if(update_score(pool[**iter], *parent, gParent, parentType, pool)){
+						onCutoff(*parent, size_t(*iter - parent->children.begin()), path.size() - 1, parentType);
 						while(++*iter != parent->children.end()){
-							if((**iter)->score == parentType ? std::numeric_limits<typename Node::NodeScore>::max() : std::numeric_limits<typename Node::NodeScore>::min()){
-								parent->height = std::min(parent->height, (**iter)->height);
+							Node &sibling = pool[**iter];
+							if(sibling.score == (parentType ? std::numeric_limits<typename Node::NodeScore>::max() : std::numeric_limits<typename Node::NodeScore>::min())){
+								parent->height = std::min(parent->height, sibling.height);
 								if(parent->height == 0){
 									break;
 								}
-							} else if((**iter)->height != infinity){
-								parent->height = std::min(parent->height, (**iter)->height+1);
+							} else if(sibling.height != infinity){
+								parent->height = std::min(parent->height, sibling.height+1);
 							}
 						}
 						if(childHeight != infinity){ // update the grandparent's height
@@ -365,14 +795,18 @@ namespace dhlib { namespace minimax {
 						parent->height = std::min(childHeight + 1, parent->height);
 					}
 				} else {
-					update_score(***iter, *parent, parentType);
+					update_score(pool[**iter], *parent, parentType);
 					if(childHeight != infinity) {
 						parent->height = std::min(childHeight + 1, parent->height);
 					}
+					if(parentType ? parent->score >= stop : parent->score <= stop){ // failed high, the caller rolls the start node back
+						path.pop_back();
+						return startNode;
+					}
 				}
 				++*iter;
-				if(*iter != parent->children.end() && (**iter)->height <= depth - path.size()){ // finished this node
-					return ***iter; // return next child
+				if(*iter != parent->children.end() && pool[**iter].height <= depth - path.size()){ // finished this node
+					return pool[**iter]; // return next child
 				}
 			}
 			path.pop_back(); // backtrack to parent and search parent's siblings
@@ -381,53 +815,159 @@ namespace dhlib { namespace minimax {
 		return startNode;
 	}
 
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
-	void minimax<Score,State,Choice,Heuristic,GetChoices>::compute(size_t depth, const marker& start) {
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	bool minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::compute(size_t depth, const marker& start) {
+		return compute(depth, start, std::numeric_limits<Score>::min(), std::numeric_limits<Score>::max());
+	}
+
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	bool minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::search_tree(size_t height) {
+		constexpr Score lowest = std::numeric_limits<Score>::min(), highest = std::numeric_limits<Score>::max();
+		constexpr size_t infinity = std::numeric_limits<size_t>::max();
+		node &rootNode = pool[root];
+		if(rootNode.height >= height){
+			return true;
+		}
+		if(rootNode.height != 0){
+			centres_[rootNode.height & 1] = rootNode.score;
+		}
+		Score lower = lowest, upper = highest, delta = aspiration_;
+		const Score centre = centres_[height & 1];
+		if(delta > 0 && centre != lowest && centre != highest){
+			lower = centre > lowest + delta ? centre - delta : lowest;
+			upper = centre < highest - delta ? centre + delta : highest;
+		}
+		std::vector<std::pair<Score, size_t>> saved; // a failed search is rolled back like a timed out one
+		while(true){
+			if(lower != lowest || upper != highest){
+				saved.assign(1, {rootNode.score, rootNode.height});
+				for(handle child : rootNode.children){
+					saved.emplace_back(pool[child].score, pool[child].height);
+				}
+			}
+			if(!compute(height, marker(*this), lower, upper)){
+				return false;
+			}
+			// outside the window the score is only a bound, the failing side moves past it and the next failure moves further
+			const Score score = rootNode.score;
+			delta = delta < highest / 2 ? delta * 2 : highest;
+			if(score <= lower && lower != lowest){
+				if constexpr (Stats::enabled) {
+					++stats_.fail_lows;
+				}
+				lower = score > lowest + delta ? score - delta : lowest;
+			} else if(score >= upper && upper != highest){
+				if constexpr (Stats::enabled) {
+					++stats_.fail_highs;
+				}
+				upper = score < highest - delta ? score + delta : highest;
+			} else {
+				break;
+			}
+			abandon(rootNode, saved, std::vector<child_iter>());
+		}
+		if(rootNode.height != infinity){
+			centres_[rootNode.height & 1] = rootNode.score;
+		}
+		return true;
+	}
+
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	bool minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::compute(size_t depth, const marker& start, Score lower, Score upper) {
 		Heuristic heuristic;
 		GetChoices getChoices;
 		constexpr size_t infinity = std::numeric_limits<size_t>::max();
 		if(start.expired()){
 			throw std::invalid_argument("compute received expired marker");
 		}
-		node_ptr startNode = start.node().lock();
-		if(startNode->height >= depth || startNode->height == infinity){
-			return;
+		node &startNode = pool[start.node()];
+		if(startNode.height >= depth || startNode.height == infinity){
+			if constexpr (Stats::enabled) {
+				stats_.depth = std::max(stats_.depth, std::min(startNode.height, depth));
+			}
+			return true;
+		}
+		std::vector<std::pair<Score, size_t>> saved; // what a timed out search restores
+		if(timed_){
+			saved.emplace_back(startNode.score, startNode.height);
+			for(handle child : startNode.children){
+				saved.emplace_back(pool[child].score, pool[child].height);
+			}
 		}
 		std::vector<child_iter> path;
 		path.reserve(depth);
 		bool nodeType = (start.path().size() & 1) == type_;
-		node* at = startNode.get();
+		const bool startType = nodeType;
+		node* at = &startNode;
 		do { // an iteration of this loop calculates the value for at, this loop ends when backtracking to the marker
 
 			// to the leaves
 			while(at->height < depth - path.size()){
 				at->height = infinity; // height is set to work with min function and indicate that node is visited
-				at->score = nodeType ? std::numeric_limits<Score>::min() : std::numeric_limits<Score>::max();
+				if(at == &startNode){ // the near bound of the window prunes the children that can't reach it
+					at->score = nodeType ? lower : upper;
+				} else {
+					at->score = nodeType ? std::numeric_limits<Score>::min() : std::numeric_limits<Score>::max();
+				}
+				at->evaluated = false;
 				if(at->children.size()){
 					path.emplace_back(at->children.begin());
-					at = at->children.front().get();
+					at = &pool[at->children.front()];
 					nodeType = !nodeType;
 				} else { //must construct remaining nodes
-					while(depth > path.size()){
+					while(depth > path.size() && at->children.empty()){ // a child shared with another line may be expanded already
 						bool childType = !nodeType;
-						for(auto &child : getChoices(at->state)){
-							auto maybeNode = nodes.find(child.second);
-							if(maybeNode != nodes.end()){ // node for child state already exists, use it
-								at->children.emplace_back(maybeNode->second);
-								at->choices.emplace_back(child.first);
-							} else {
-								at->children.emplace_back(std::make_shared<node>(*this, child.second, childType));
-								at->choices.emplace_back(child.first);
-								nodes.emplace(child.second, weak_ptr(at->children.back()));
+						auto children = details::children_of<Choice>(getChoices, at->state);
+						if constexpr (Stats::enabled) {
+							++stats_.expanded;
+						}
+						typename table_type::entry entry;
+						bool mirrored;
+						Choice hint;
+						const Choice* stored = nullptr;
+						if(table.probe(details::canonical_hash<GetChoices>(at->state, mirrored), entry) && entry.has_choice){
+							hint = details::orient<GetChoices>(entry.choice, mirrored);
+							stored = &hint;
+						}
+						const size_t ply = path.size();
+						details::insertion_sort(children.begin(), children.end(), [this, at, stored, ply, nodeType](const auto& a, const auto& b){
+							return order_.rank(a.first, details::move_key<GetChoices>(at->state, a.first, a.second), ply, nodeType, stored) >
+								order_.rank(b.first, details::move_key<GetChoices>(at->state, b.first, b.second), ply, nodeType, stored);
+						});
+						at->children.reserve(children.size()); // exactly once, the lists never grow after expansion
+						at->choices.reserve(children.size());
+						for(auto &child : children){
+							std::uint64_t key = hash(child.second);
+							handle existing = find(key, child.second);
+							if(existing != null_handle){ // node for child state already exists, use it
+								at->children.emplace_back(existing);
+								++pool[existing].refs;
+								if constexpr (Stats::enabled) {
+									++stats_.transpositions;
+								}
+							} else { // slabs never move, so at stays valid while the pool grows
+								reclaim(RECLAIM_PER_NODE); // at is reachable so it is never among the nodes freed
+								handle created = pool.allocate(*this, child.second, childType);
+								pool[created].refs = 1;
+								if constexpr (Stats::enabled) {
+									++stats_.created;
+								}
+								at->children.emplace_back(created);
+								table.link(key, created);
 							}
+							at->choices.emplace_back(child.first);
 						}
 						at->height = infinity; // set height to infinity for min and for if this node is a dead end
 						if(at->children.empty()){
 							break; // dead end
 						}
-						at->children.shrink_to_fit();
+						if constexpr (details::batched<Heuristic, State, Score>::value) {
+							if(depth == path.size() + 1){
+								evaluate_leaves(heuristic, *at, nodeType);
+							}
+						}
 						path.emplace_back(at->children.begin());
-						at = at->children.front().get();
+						at = &pool[at->children.front()];
 						nodeType = !nodeType;
 					}
 				}
@@ -435,75 +975,394 @@ namespace dhlib { namespace minimax {
 
 			// if at is a leaf, calculate its value
 			if(at->children.empty()) {
-				at->score = heuristic(at->state);
+				if(!at->evaluated){
+					at->score = heuristic(at->state);
+					if constexpr (Stats::enabled) {
+						++stats_.evaluated;
+					}
+				}
+				at->evaluated = false;
+				if(timed_ && ++checks_ % CHECK_INTERVAL == 0 && (cancel_.load(std::memory_order_relaxed) || clock::now() >= deadline_)){
+					abandon(startNode, saved, path);
+					return false;
+				}
 			}
 
 			// backtrack
-			at = &next_node(depth, *startNode, path, nodeType);
-		} while(startNode.get() != at);
-/*
-		// update the parents
-		std::deque<weak_ptr> &parents = start.path();
-		for(auto parentPtr = parents.rbegin(); parentPtr < parents.rend()-1; ++parentPtr){
-			node& parent = *parentPtr->lock();
-			bool parentType = !nodeType;
+			at = &next_node(depth, startNode, startType ? upper : lower, path, nodeType, pool, [this, depth](node &parent, size_t index, size_t ply, bool parentType){
+				const node &child = pool[parent.children[index]];
+				if constexpr (Stats::enabled) {
+					++stats_.cutoffs;
+				}
+				order_.cutoff(parent.choices[index], details::move_key<GetChoices>(parent.state, parent.choices[index], child.state),
+						ply, parentType, depth - ply, index == 0);
+			});
+		} while(&startNode != at);
+		if((startNode.score <= lower && lower != std::numeric_limits<Score>::min()) || (startNode.score >= upper && upper != std::numeric_limits<Score>::max())){
+			return true; // a bound, the caller searches again with a wider window
+		}
+
+		// remember the result so later searches of this position start from its best choice
+		bool mirrored;
+		std::uint64_t key = details::canonical_hash<GetChoices>(startNode.state, mirrored);
+		Choice canonical;
+		const Choice* bestChoice = nullptr;
+		for(auto child = startNode.children.cbegin(); child != startNode.children.cend(); ++child){
+			if(pool[*child].score == startNode.score){
+				canonical = details::orient<GetChoices>(startNode.choices[child - startNode.children.cbegin()], mirrored);
+				bestChoice = &canonical;
+				break;
+			}
+		}
+		table.store(key, startNode.score, bound::exact, startNode.height, bestChoice, start.node());
+		if constexpr (Stats::enabled) {
+			stats_.depth = std::max(stats_.depth, depth);
+		}
+		return true;
+	};
+
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	void minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::abandon(
+			node& startNode, const std::vector<std::pair<Score, size_t>>& saved, const std::vector<child_iter>& path
+	){
+		// nodes below the start node's children fall back to their heuristic value, which is what a height of 0 means
+		Heuristic heuristic;
+		for(auto iter = path.begin() + (path.size() ? 1 : 0); iter < path.end(); ++iter){
+			node &n = pool[**iter];
+			n.height = 0;
+			n.score = heuristic(n.state);
+		}
+		startNode.score = saved.front().first;
+		startNode.height = saved.front().second;
+		for(size_t i = 0; i < startNode.children.size(); ++i){
+			node &child = pool[startNode.children[i]];
+			if(i + 1 < saved.size()){
+				child.score = saved[i + 1].first;
+				child.height = saved[i + 1].second;
+			} else { // expanded by the abandoned search
+				child.height = 0;
+				child.score = heuristic(child.state);
+			}
+		}
+	}
+
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	size_t minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::compute_for(std::chrono::milliseconds budget, size_t maxHeight) {
+		stop_pondering();
+		begin_stats();
+		reclaim(RECLAIM_PER_SEARCH);
+		constexpr size_t infinity = std::numeric_limits<size_t>::max();
+		clock::time_point begin = clock::now();
+		deadline_ = begin + budget;
+		if(table_search()){
+			size_t height = search_parallel(maxHeight, deadline_);
+			end_stats();
+			return height;
+		}
+		for(size_t height = pool[root].height + 1; pool[root].height < maxHeight && pool[root].height != infinity; ++height){
+			if(height > 1 && clock::now() - begin > budget / 2){
+				break; // the next iteration costs more than everything so far, it is unlikely to finish
+			}
+			timed_ = height > 1; // the first iteration always completes so there is a choice to make
+			bool finished = search_tree(height);
+			timed_ = false;
+			if(!finished){
+				break;
+			}
+			order_principal_variation();
+		}
+		end_stats();
+		return pool[root].height;
+	}
+
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	void minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::ponder(size_t maxHeight) {
+		stop_pondering();
+		cancel_ = false;
+		deadline_ = clock::time_point::max();
+		ponderState_ = state();
+		ponderScore_ = pool[root].score;
+		ponderer_ = std::thread([this, maxHeight](){
+			constexpr size_t infinity = std::numeric_limits<size_t>::max();
+			begin_stats();
+			while(pending_.size() && !cancel_){ // off the clock, a chunk at a time so a stop never waits for the whole backlog
+				reclaim(RECLAIM_PER_SEARCH);
+			}
+			if(table_search()){
+				search_parallel(maxHeight, clock::time_point::max());
+				end_stats();
+				return;
+			}
+			for(size_t height = pool[root].height + 1; height <= maxHeight && pool[root].height != infinity && !cancel_; ++height){
+				timed_ = true; // any iteration may be cut short, including the first
+				bool finished = search_tree(height);
+				timed_ = false;
+				if(!finished){
+					break;
+				}
+				order_principal_variation();
+			}
+			end_stats();
+		});
+	}
+
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	void minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::stop_pondering() noexcept {
+		if(!ponderer_.joinable()){
+			return;
+		}
+		cancel_ = true;
+		stop_ = true;
+		ponderer_.join();
+		cancel_ = false;
+	}
 
-			// update score
-			if(parentType == MAX){
-				parent.score = std::max(at->score, parent.score);
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	bool minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::search_root(
+			searcher& s, size_t height, size_t offset, std::vector<size_t>& order, std::vector<Score>& values, Score& guess, Score (&centres)[2]
+	){
+		const node &rootNode = pool[root];
+		if(algorithm_ == search_algorithm::mtdf){ // the root itself is searched, its children only get the bounds left in the table
+			Score score = s.mtdf(rootNode.state, height, guess, type_);
+			if(s.stopped()){
+				return false;
+			}
+			Choice top;
+			bool found = s.top(top);
+			size_t bestAt = 0;
+			for(size_t i = 0; i < order.size(); ++i){
+				size_t child = order[i];
+				typename table_type::entry entry;
+				if(table.probe(hash(pool[rootNode.children[child]].state), entry) && entry.type != bound::none){
+					values[child] = type_ ? std::min(entry.score, score) : std::max(entry.score, score);
+				} else {
+					values[child] = type_ ? std::numeric_limits<Score>::min() : std::numeric_limits<Score>::max();
+				}
+				if(found && rootNode.choices[child] == top){
+					bestAt = i;
+				}
+			}
+			values[order[bestAt]] = score;
+			std::rotate(order.begin(), order.begin() + bestAt, order.begin() + bestAt + 1);
+			guess = score;
+			return true;
+		}
+		constexpr Score lowest = std::numeric_limits<Score>::min(), highest = std::numeric_limits<Score>::max();
+		Score lower = lowest, upper = highest, delta = aspiration_;
+		const Score centre = centres[height & 1];
+		if(delta > 0 && centre != lowest && centre != highest){ // a score, not unknown or the bound of a node never searched
+			lower = centre > lowest + delta ? centre - delta : lowest;
+			upper = centre < highest - delta ? centre + delta : highest;
+		}
+		Score best;
+		size_t bestAt;
+		while(true){
+			Score alpha = lower, beta = upper;
+			best = type_ ? lowest : highest;
+			bestAt = 0;
+			for(size_t i = 0; i < order.size() && alpha < beta; ++i){
+				size_t child = order[(i + offset) % order.size()];
+				Score value = s.search(pool[rootNode.children[child]].state, height - 1, alpha, beta, !type_, i == 0);
+				if(s.stopped()){
+					return false;
+				}
+				values[child] = value;
+				if(type_ ? value > best : value < best){
+					best = value;
+					bestAt = (i + offset) % order.size();
+				}
+				if(type_){
+					alpha = std::max(alpha, best);
+				} else {
+					beta = std::min(beta, best);
+				}
+			}
+			// outside the window best is only a bound, the failing side moves past it and the next failure moves further
+			delta = delta < highest / 2 ? delta * 2 : highest;
+			if(best <= lower && lower != lowest){
+				s.failed(false);
+				lower = best > lowest + delta ? best - delta : lowest;
+			} else if(best >= upper && upper != highest){
+				s.failed(true);
+				upper = best < highest - delta ? best + delta : highest;
 			} else {
-				parent.score = std::min(at->score, parent.score);
+				break;
 			}
+		}
+		std::rotate(order.begin(), order.begin() + bestAt, order.begin() + bestAt + 1);
+		guess = best;
+		centres[std::max(height, rootNode.height) & 1] = best; // the table answers shallower iterations from the root's searches
+		return true;
+	}
 
-			// update height
-			if(at->height >= parent.height) {
-				parent.height = infinity;
-				for(node_ptr &child : parent.children){
-					if(child->height == infinity){
-						parent.height = infinity;
-					} else {
-						parent.height = std::min(parent.height, child->height+1);
-					}
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	size_t minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::search_parallel(size_t maxHeight, clock::time_point deadline) {
+		constexpr size_t infinity = std::numeric_limits<size_t>::max();
+		clock::time_point begin = clock::now();
+		if(pool[root].children.empty()){
+			compute(1, marker(*this)); // the tree holds the root's children so choose and progress work as usual
+		}
+		node &rootNode = pool[root];
+		if(rootNode.children.empty() || rootNode.height == infinity){
+			return rootNode.height;
+		}
+		maxHeight = std::min(maxHeight, table_type::MAX_DEPTH);
+		stop_ = false;
+		if(cancel_){ // stop_pondering may have come before the reset
+			stop_ = true;
+		}
+		std::atomic<std::size_t> helperNodes(0), helperResearches(0), helperExpansions(0), helperEvaluations(0), helperCutoffs(0);
+		std::atomic<std::size_t> helperFailLows(0), helperFailHighs(0);
+		std::vector<std::thread> helpers;
+		const search_algorithm algorithm = algorithm_ == search_algorithm::tree ? search_algorithm::alphabeta : algorithm_;
+		Score guess = rootNode.score; // the first guess of MTD(f), every iteration starts from the last one's score
+		Score centres[2] = {centres_[0], centres_[1]};
+		if(rootNode.height != 0){
+			centres[rootNode.height & 1] = rootNode.score;
+		}
+		for(unsigned id = 1; id < threads_; ++id){
+			helpers.emplace_back([this, id, maxHeight, algorithm, guess, centres, &helperNodes, &helperResearches, &helperExpansions, &helperEvaluations,
+					&helperCutoffs, &helperFailLows, &helperFailHighs](){
+				searcher s(table, stop_, clock::time_point::max(), algorithm);
+				std::vector<size_t> order(pool[root].children.size());
+				std::vector<Score> values(order.size());
+				for(size_t i = 0; i < order.size(); ++i){
+					order[i] = i;
+				}
+				Score helperGuess = guess, helperCentres[2] = {centres[0], centres[1]};
+				for(size_t height = 1 + (id & 1); height <= maxHeight + 1 && !s.stopped(); ++height){
+					search_root(s, height, id, order, values, helperGuess, helperCentres);
 				}
+				helperNodes += s.nodes();
+				helperResearches += s.researches();
+				helperExpansions += s.expansions();
+				helperEvaluations += s.evaluations();
+				helperCutoffs += s.order().stats.cutoffs;
+				helperFailLows += s.fail_lows();
+				helperFailHighs += s.fail_highs();
+			});
+		}
+		searcher s(table, stop_, deadline, algorithm);
+		std::vector<size_t> order(rootNode.children.size());
+		std::vector<Score> values(order.size()), completed;
+		for(size_t i = 0; i < order.size(); ++i){
+			order[i] = i;
+		}
+		size_t height = 0;
+		bool solved = false;
+		while(height < maxHeight){
+			if(height > 0 && deadline != clock::time_point::max() && clock::now() - begin > (deadline - begin) / 2){
+				break; // the next iteration is unlikely to finish
 			}
-			at = &parent;
-			nodeType = parentType;
-		}*/
-	};
+			s.reset_horizon();
+			if(!search_root(s, height + 1, 0, order, values, guess, centres)){
+				break;
+			}
+			completed = values;
+			++height;
+			if(!s.horizon()){
+				solved = true; // every line ended the game, deeper iterations would repeat this one
+				break;
+			}
+		}
+		stop_ = true;
+		for(std::thread &helper : helpers){
+			helper.join();
+		}
+		nodes_ = s.nodes() + helperNodes;
+		researches_ = s.researches() + helperResearches;
+		if constexpr (Stats::enabled) {
+			stats_.expanded += s.expansions() + helperExpansions;
+			stats_.evaluated += s.evaluations() + helperEvaluations;
+			stats_.cutoffs += s.order().stats.cutoffs + helperCutoffs;
+			stats_.fail_lows += s.fail_lows() + helperFailLows;
+			stats_.fail_highs += s.fail_highs() + helperFailHighs;
+			stats_.depth = std::max(stats_.depth, height);
+		}
+		order_.stats.cutoffs += s.order().stats.cutoffs;
+		order_.stats.first += s.order().stats.first;
+		if(height == 0){
+			return rootNode.height;
+		}
+		centres_[0] = centres[0];
+		centres_[1] = centres[1];
+
+		// children the tree never expanded keep a height of 0 so the tree still expands them when it needs them,
+		// the best child is moved to the front so choose prefers it over a sibling whose upper bound ties it
+		for(size_t i = 0; i < rootNode.children.size(); ++i){
+			node &child = pool[rootNode.children[i]];
+			if(child.height != infinity){
+				child.score = completed[i];
+				child.height = child.children.empty() ? 0 : height - 1;
+			}
+		}
+		size_t best = order.front();
+		rootNode.score = pool[rootNode.children[best]].score;
+		rootNode.height = solved ? infinity : height;
+		std::rotate(rootNode.children.begin(), rootNode.children.begin() + best, rootNode.children.begin() + best + 1);
+		std::rotate(rootNode.choices.begin(), rootNode.choices.begin() + best, rootNode.choices.begin() + best + 1);
+		bool mirrored;
+		std::uint64_t key = details::canonical_hash<GetChoices>(rootNode.state, mirrored);
+		const Choice canonical = details::orient<GetChoices>(rootNode.choices.front(), mirrored);
+		table.store(key, rootNode.score, bound::exact, height, &canonical, root);
+		return height;
+	}
+
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	void minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::order_principal_variation() noexcept {
+		node *at = &pool[root];
+		for(size_t ply = 0; ply < pool[root].height && at->children.size(); ++ply){
+			size_t best = 0;
+			while(best < at->children.size() && pool[at->children[best]].score != at->score){
+				++best;
+			}
+			if(best == at->children.size()){
+				return;
+			}
+			std::rotate(at->children.begin(), at->children.begin() + best, at->children.begin() + best + 1);
+			std::rotate(at->choices.begin(), at->choices.begin() + best, at->choices.begin() + best + 1);
+			at = &pool[at->children.front()];
+		}
+	}
 
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
-	const Choice& minimax<Score,State,Choice,Heuristic,GetChoices>::choose(const Choice& def) const noexcept {
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	Choice minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::choose(const Choice& def) const noexcept {
 		const Choice* bestChoice = &def;
+		const node &rootNode = pool[root];
 		Score best = type_ ? std::numeric_limits<Score>::min() : std::numeric_limits<Score>::max();
 		for(
-			auto child = root->children.cbegin(), choice = root->choices.cbegin();
-			child != root->children.end();
+			auto child = rootNode.children.cbegin(), choice = rootNode.choices.cbegin();
+			child != rootNode.children.end();
 			++child, ++choice
 		){
-			if(type_ ? ((*child)->score > best) : ((*child)->score < best)){
-				best = (*child)->score;
+			const Score &childScore = pool[*child].score;
+			if(type_ ? (childScore > best) : (childScore < best)){
+				best = childScore;
 				bestChoice = &(*choice);
 			}
 		}
-		return *bestChoice;
+		return bestChoice == &def ? def : details::orient<GetChoices>(*bestChoice, mirrored_);
 	}
 
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
-	std::ostream& minimax<Score,State,Choice,Heuristic,GetChoices>::print(std::ostream& os) const {
-		for(auto iter = nodes.cbegin(); iter != nodes.cend(); ++iter){
-			node& node = *iter->second.lock();
-			std::cout << &node << ": " << " score: " << node.score << " children: ";
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	std::ostream& minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::print(std::ostream& os) const {
+		for(handle h = 0; h < pool.capacity(); ++h){
+			if(!pool.live(h)){
+				continue;
+			}
+			const node& node = pool[h];
+			std::cout << h << ": " << " score: " << node.score << " children: ";
 			for(auto child = node.children.begin(); child != node.children.end(); ++child){
-				std::cout << &(*child) << ' ';
+				std::cout << *child << ' ';
 			}
 			std::cout << std::endl;
 		}
 		return std::cout;
 	}
 
-	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
-	void minimax<Score,State,Choice,Heuristic,GetChoices>::verify(){
-		root->verifyNode(type_);
+	template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices, typename Stats>
+	void minimax<Score,State,Choice,Heuristic,GetChoices,Stats>::verify(){
+		pool[root].verifyNode(type_, pool);
 	}
 } }
 
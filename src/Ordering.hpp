@@ -0,0 +1,145 @@
+/*
+ * Ordering.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef ORDERING_H_
+#define ORDERING_H_
+
+#include <array>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace dhlib { namespace minimax {
+
+	namespace details {
+		/* GetChoices::KEYS, the number of distinct move keys GetChoices::key returns, or 0 when it has none */
+		template<typename GetChoices, typename = void>
+		struct move_keys : std::integral_constant<std::size_t, 0> { };
+		template<typename GetChoices>
+		struct move_keys<GetChoices, std::void_t<decltype(GetChoices::KEYS)>> : std::integral_constant<std::size_t, GetChoices::KEYS> { };
+
+		/* the history slot of the move from parent to child */
+		template<typename GetChoices, typename State, typename Choice>
+		std::size_t move_key(const State& parent, const Choice& choice, const State& child) noexcept {
+			if constexpr (move_keys<GetChoices>::value != 0) {
+				return GetChoices::key(parent, choice, child);
+			} else {
+				return 0;
+			}
+		}
+
+		/* stable and allocation free, move lists are short */
+		template<typename Iter, typename Less>
+		void insertion_sort(Iter begin, Iter end, Less less) {
+			for(Iter i = begin; i != end; ++i){
+				for(Iter j = i; j != begin && less(*j, *(j - 1)); --j){
+					std::iter_swap(j, j - 1);
+				}
+			}
+		}
+	}
+
+	/**
+	 * how often the first child searched was the one that ended a node's search early
+	 */
+	struct cutoff_stats {
+		std::size_t cutoffs = 0;
+		std::size_t first = 0;
+		double first_rate() const noexcept {
+			return cutoffs ? double(first) / cutoffs : 0;
+		}
+	};
+
+	/**
+	 * Ranks moves for search: the transposition table's best choice first, then the two killer moves of the ply,
+	 * then the history of the move's key for the player moving. A move that ends a search early becomes a killer
+	 * for its ply and adds depth squared to its history. Moves that rank equally keep the order GetChoices gave them.
+	 * 	Keys: the number of history slots per player, 0 disables the history
+	 */
+	template<typename Choice, std::size_t Keys>
+	class move_order {
+	public:
+		using rank_type = std::int64_t;
+		static constexpr std::size_t MAX_PLY = 128;
+		static constexpr rank_type BEST = std::numeric_limits<rank_type>::max();
+		static constexpr rank_type KILLER = BEST - 2; // and KILLER - 1 for the older killer
+		static constexpr rank_type HISTORY_LIMIT = rank_type(1) << 40;
+
+		move_order() noexcept {
+			clear();
+		}
+
+		rank_type rank(const Choice& choice, std::size_t key, std::size_t ply, bool type, const Choice* best) const noexcept {
+			if(best && choice == *best){
+				return BEST;
+			}
+			if(ply < MAX_PLY){
+				for(std::size_t k = 0; k < 2; ++k){
+					if(killers_[ply][k].set && killers_[ply][k].choice == choice){
+						return KILLER - k;
+					}
+				}
+			}
+			return Keys ? history_[type][key % (Keys ? Keys : 1)] : 0;
+		}
+
+		/**
+		 * records that choice ended the search of a node at ply that was searched to depth
+		 */
+		void cutoff(const Choice& choice, std::size_t key, std::size_t ply, bool type, std::size_t depth, bool first) noexcept {
+			++stats.cutoffs;
+			stats.first += first;
+			if(ply < MAX_PLY && !(killers_[ply][0].set && killers_[ply][0].choice == choice)){
+				killers_[ply][1] = killers_[ply][0];
+				killers_[ply][0].choice = choice;
+				killers_[ply][0].set = true;
+			}
+			if(Keys){
+				rank_type &history = history_[type][key % (Keys ? Keys : 1)];
+				history += rank_type(depth) * rank_type(depth);
+				if(history > HISTORY_LIMIT){
+					age();
+				}
+			}
+		}
+
+		/**
+		 * halves the history and forgets the killers, for when the root moves and plies no longer line up
+		 */
+		void age() noexcept {
+			for(auto &player : history_){
+				for(rank_type &history : player){
+					history /= 2;
+				}
+			}
+			for(auto &ply : killers_){
+				ply[0].set = ply[1].set = false;
+			}
+		}
+
+		void clear() noexcept {
+			for(auto &player : history_){
+				player.fill(0);
+			}
+			for(auto &ply : killers_){
+				ply[0].set = ply[1].set = false;
+			}
+			stats = cutoff_stats();
+		}
+
+		cutoff_stats stats;
+	private:
+		struct killer {
+			Choice choice;
+			bool set;
+		};
+		std::array<std::array<killer, 2>, MAX_PLY> killers_;
+		std::array<std::array<rank_type, Keys ? Keys : 1>, 2> history_;
+	};
+} }
+
+#endif /* ORDERING_H_ */
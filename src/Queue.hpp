@@ -0,0 +1,65 @@
+/*
+ * Queue.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace dhlib { namespace minimax {
+
+	/**
+	 * A bounded queue between one producer thread and one consumer thread that never locks or waits. Each side
+	 * writes only its own index and reads the other's with acquire ordering, so a slot is always written before
+	 * the index that hands it over. The indices only grow, their difference is the number of queued values.
+	 */
+	template<typename T, std::size_t Capacity>
+	class spsc_queue {
+		static_assert(Capacity && !(Capacity & (Capacity - 1)), "Capacity must be a power of 2");
+		static constexpr std::size_t MASK = Capacity - 1;
+		static constexpr std::size_t LINE = 64; // the indices get a cache line each so the two sides don't share one
+	public:
+		/**
+		 * called only by the producer, returns false and leaves value alone if the queue is full
+		 */
+		bool push(T& value) noexcept(std::is_nothrow_move_assignable<T>::value) {
+			const std::size_t tail = tail_.load(std::memory_order_relaxed);
+			if(tail - head_.load(std::memory_order_acquire) == Capacity){
+				return false;
+			}
+			slots_[tail & MASK] = std::move(value);
+			tail_.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * called only by the consumer, returns false if the queue is empty
+		 */
+		bool pop(T& value) noexcept(std::is_nothrow_move_assignable<T>::value) {
+			const std::size_t head = head_.load(std::memory_order_relaxed);
+			if(head == tail_.load(std::memory_order_acquire)){
+				return false;
+			}
+			value = std::move(slots_[head & MASK]);
+			head_.store(head + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool empty() const noexcept {
+			return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+		}
+	private:
+		std::array<T, Capacity> slots_;
+		alignas(LINE) std::atomic<std::size_t> head_{0}; // next slot the consumer pops
+		alignas(LINE) std::atomic<std::size_t> tail_{0}; // next slot the producer fills
+	};
+} }
+
+#endif /* QUEUE_H_ */
@@ -0,0 +1,268 @@
+/*
+ * Search.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef SEARCH_H_
+#define SEARCH_H_
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "Transposition.hpp"
+#include "Ordering.hpp"
+#include "Choices.hpp"
+
+namespace dhlib { namespace minimax {
+
+	/**
+	 * how the root is searched
+	 */
+	enum class search_algorithm : std::uint8_t {
+		tree, // alpha-beta over the node tree, with threads the table searchers use alphabeta
+		alphabeta, // full window alpha-beta over the transposition table
+		pvs, // principal variation search, every child after the first gets a null window first
+		mtdf // MTD(f), null window searches of the root converging on the last iteration's score
+	};
+
+	namespace details {
+		/**
+		 * Depth first alpha-beta over states that keeps no tree, everything it learns goes to the transposition
+		 * table. Each search thread owns one, they only share the table and the stop flag.
+		 */
+		template<typename Score, typename State, typename Choice, typename Heuristic, typename GetChoices>
+		class searcher {
+		public:
+			using table_type = transposition_table<Score, Choice>;
+			using clock = std::chrono::steady_clock;
+			using order_type = move_order<Choice, move_keys<GetChoices>::value>;
+			static constexpr std::size_t CHECK_INTERVAL = 1024; // nodes between deadline checks
+
+			searcher(
+					table_type &table, std::atomic<bool> &stop, clock::time_point deadline = clock::time_point::max(),
+					search_algorithm algorithm = search_algorithm::alphabeta
+			) noexcept :
+				table_(table), stop_(stop), deadline_(deadline), pvs_(algorithm == search_algorithm::pvs),
+				nodes_(0), researches_(0), failLows_(0), failHighs_(0), expansions_(0), evaluations_(0), horizon_(false), ply_(0),
+				hasTop_(false), top_() { }
+
+			/**
+			 * scores state to depth plies, type is true when the maximizing player moves. A score outside (alpha,beta) is only a bound
+			 * on the true score. The result is meaningless once stopped() is true.
+			 */
+			Score alphabeta(const State& state, std::size_t depth, Score alpha, Score beta, bool type) {
+				if((++nodes_ % CHECK_INTERVAL) == 0 && clock::now() >= deadline_){
+					stop_.store(true, std::memory_order_relaxed);
+				}
+				if(stopped()){
+					return type ? alpha : beta;
+				}
+				bool mirrored;
+				std::uint64_t key = canonical_hash<GetChoices>(state, mirrored);
+				typename table_type::entry entry;
+				bool hit = table_.probe(key, entry) && entry.type != bound::none;
+				const Choice hint = hit && entry.has_choice ? orient<GetChoices>(entry.choice, mirrored) : Choice();
+				if(ply_ == 0){ // replaced by the search's own best choice if it gets that far
+					hasTop_ = hit && entry.has_choice;
+					top_ = hint;
+				}
+				const Score alphaOrig = alpha, betaOrig = beta;
+				if(hit && entry.depth >= depth){
+					horizon_ |= entry.depth != table_type::SOLVED;
+					if(entry.type == bound::exact){
+						return entry.score;
+					} else if(entry.type == bound::lower){
+						alpha = std::max(alpha, entry.score);
+					} else {
+						beta = std::min(beta, entry.score);
+					}
+					if(alpha >= beta){
+						return entry.score;
+					}
+				}
+				if(depth == 0){
+					horizon_ = true;
+					++evaluations_;
+					return heuristic_(state);
+				}
+				auto children = children_of<Choice>(getChoices_, state);
+				++expansions_;
+				if(children.empty()){ // the game is over, this score holds at any depth
+					++evaluations_;
+					Score score = heuristic_(state);
+					table_.store(key, score, bound::exact, table_type::SOLVED, nullptr);
+					return score;
+				}
+				const Choice* stored = hit && entry.has_choice ? &hint : nullptr;
+				insertion_sort(children.begin(), children.end(), [this, &state, stored, type](const auto& a, const auto& b){
+					return order_.rank(a.first, move_key<GetChoices>(state, a.first, a.second), ply_, type, stored) >
+						order_.rank(b.first, move_key<GetChoices>(state, b.first, b.second), ply_, type, stored);
+				});
+				Score best = type ? std::numeric_limits<Score>::min() : std::numeric_limits<Score>::max();
+				const Choice* bestChoice = nullptr;
+				bool horizon = horizon_;
+				horizon_ = false;
+				for(auto &child : children){
+					++ply_;
+					Score value = search(child.second, depth - 1, alpha, beta, !type, &child == &children.front());
+					--ply_;
+					if(stopped()){
+						return best;
+					}
+					if(!bestChoice || (type ? value > best : value < best)){
+						best = value;
+						bestChoice = &child.first;
+					}
+					if(type){
+						alpha = std::max(alpha, best);
+					} else {
+						beta = std::min(beta, best);
+					}
+					if(alpha >= beta){
+						order_.cutoff(child.first, move_key<GetChoices>(state, child.first, child.second), ply_, type, depth, &child == &children.front());
+						break;
+					}
+				}
+				bound result = best <= alphaOrig ? bound::upper : best >= betaOrig ? bound::lower : bound::exact;
+				const Choice canonical = orient<GetChoices>(*bestChoice, mirrored);
+				table_.store(key, best, result, horizon_ ? depth : table_type::SOLVED, &canonical); // a subtree that never reached the depth limit holds at any depth
+				if(ply_ == 0){
+					hasTop_ = true;
+					top_ = *bestChoice;
+				}
+				horizon_ |= horizon;
+				return best;
+			}
+
+			/**
+			 * scores a child of the node being searched, under PVS every child but the first is searched with a null window
+			 * and searched again with the full window only if it lands inside it
+			 */
+			Score search(const State& state, std::size_t depth, Score alpha, Score beta, bool type, bool first) {
+				if(!pvs_ || first){
+					return alphabeta(state, depth, alpha, beta, type);
+				}
+				// type is the child's, so the parent maximizes when it is false
+				Score value = type ? alphabeta(state, depth, beta - 1, beta, type) : alphabeta(state, depth, alpha, alpha + 1, type);
+				if(value > alpha && value < beta && !stopped()){
+					++researches_;
+					value = alphabeta(state, depth, alpha, beta, type);
+				}
+				return value;
+			}
+
+			/**
+			 * MTD(f), null window searches of state that narrow the bounds on its score from guess until they meet.
+			 * The best choice of the last search that failed high, or of the first if none did, is left in top().
+			 */
+			Score mtdf(const State& state, std::size_t depth, Score guess, bool type) {
+				Score lower = std::numeric_limits<Score>::min(), upper = std::numeric_limits<Score>::max();
+				Score score = guess;
+				bool hasBest = false;
+				Choice best = Choice();
+				for(bool first = true; lower < upper; first = false){
+					Score beta = score == lower ? score + 1 : score; // the search tells whether the score is at least beta
+					score = alphabeta(state, depth, beta - 1, beta, type);
+					if(stopped()){
+						return score;
+					}
+					if(!first){
+						++researches_;
+					}
+					if(score < beta){
+						upper = score;
+					} else {
+						lower = score;
+					}
+					if(hasTop_ && (score >= beta || !hasBest)){
+						hasBest = true;
+						best = top_;
+					}
+				}
+				hasTop_ = hasBest;
+				top_ = best;
+				return score;
+			}
+
+			bool stopped() const noexcept {
+				return stop_.load(std::memory_order_relaxed);
+			}
+			std::size_t nodes() const noexcept {
+				return nodes_;
+			}
+
+			/**
+			 * searches repeated with another window, PVS re-searches, MTD(f) searches after the first of each call and
+			 * root searches widened after failing outside their aspiration window
+			 */
+			std::size_t researches() const noexcept {
+				return researches_;
+			}
+
+			/**
+			 * called when a search of the root with an aspiration window fails, high if the score is at least its top
+			 */
+			void failed(bool high) noexcept {
+				++researches_;
+				++(high ? failHighs_ : failLows_);
+			}
+			std::size_t fail_lows() const noexcept {
+				return failLows_;
+			}
+			std::size_t fail_highs() const noexcept {
+				return failHighs_;
+			}
+			std::size_t expansions() const noexcept {
+				return expansions_;
+			}
+			std::size_t evaluations() const noexcept {
+				return evaluations_;
+			}
+
+			/**
+			 * the best choice found for the state the last call started from, false if it has none
+			 */
+			bool top(Choice &choice) const noexcept {
+				choice = top_;
+				return hasTop_;
+			}
+			const order_type& order() const noexcept {
+				return order_;
+			}
+
+			/**
+			 * whether any search since the last reset stopped at the depth limit rather than at the end of the game
+			 */
+			bool horizon() const noexcept {
+				return horizon_;
+			}
+			void reset_horizon() noexcept {
+				horizon_ = false;
+			}
+		private:
+			table_type &table_;
+			std::atomic<bool> &stop_;
+			clock::time_point deadline_;
+			bool pvs_;
+			std::size_t nodes_;
+			std::size_t researches_;
+			std::size_t failLows_;
+			std::size_t failHighs_;
+			std::size_t expansions_;
+			std::size_t evaluations_;
+			bool horizon_;
+			std::size_t ply_;
+			bool hasTop_;
+			Choice top_;
+			order_type order_;
+			Heuristic heuristic_;
+			GetChoices getChoices_;
+		};
+	}
+} }
+
+#endif /* SEARCH_H_ */
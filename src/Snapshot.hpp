@@ -0,0 +1,278 @@
+/*
+ * Snapshot.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "Minimax.hpp"
+
+namespace dhlib { namespace minimax {
+
+	/**
+	 * Snapshots keep the top of a minimax tree across process restarts. The file is a header and then one record
+	 * per node in breadth first order from the root:
+	 * 	State, Score, uint64 height, uint32 child count and per child its Choice and uint32 record index.
+	 * State, Score and Choice are written as their bytes, so they must be trivially copyable and a snapshot is
+	 * only read back by a build with the same sizes. Parents come before their children, as breadth first order
+	 * gives when every path to a position has the same length, a file cut short still loads every complete record
+	 * and the nodes that lost children to the cut fall back to leaves.
+	 */
+	constexpr std::uint32_t SNAPSHOT_VERSION = 1;
+
+	namespace details {
+		struct snapshot_header {
+			char magic[4]; // "MMSN"
+			std::uint32_t version;
+			std::uint32_t stateBytes;
+			std::uint32_t scoreBytes;
+			std::uint32_t choiceBytes;
+			std::uint32_t reserved;
+			std::uint64_t count; // records written, a truncated file holds fewer
+		};
+		constexpr char SNAPSHOT_MAGIC[4] = {'M', 'M', 'S', 'N'};
+		constexpr std::uint32_t NO_RECORD = std::numeric_limits<std::uint32_t>::max();
+
+		template<typename T>
+		void put(std::ofstream& out, const T& value) {
+			out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+		template<typename T>
+		bool take(const char*& at, const char* end, T& value) noexcept {
+			if(std::size_t(end - at) < sizeof(T)){
+				return false;
+			}
+			std::memcpy(&value, at, sizeof(T));
+			at += sizeof(T);
+			return true;
+		}
+	}
+
+	/**
+	 * Writes the nodes within maxDepth plies of the root to path, stopping any pondering first. Nodes at maxDepth
+	 * are written as leaves and the heights above them capped to match. The file is written beside path and
+	 * renamed over it, so a reader never sees half of it, throws runtime_error if it can't be written.
+	 */
+	template<typename Minimax>
+	void save_snapshot(Minimax& mm, const std::string& path, std::size_t maxDepth = std::numeric_limits<std::size_t>::max()) {
+		using State = typename Minimax::state_type;
+		using Score = typename Minimax::score_type;
+		using Choice = typename Minimax::choice_type;
+		static_assert(std::is_trivially_copyable<State>::value && std::is_trivially_copyable<Score>::value && std::is_trivially_copyable<Choice>::value,
+			"snapshots write State, Score and Choice as bytes");
+		mm.stop_pondering();
+
+		std::vector<handle> order = {mm.root};
+		std::vector<std::size_t> depth = {0};
+		std::vector<std::uint32_t> index(mm.pool.capacity(), details::NO_RECORD);
+		index[mm.root] = 0;
+		for(std::size_t i = 0; i < order.size(); ++i){
+			if(depth[i] >= maxDepth){
+				continue;
+			}
+			for(handle child : mm.pool[order[i]].children){
+				if(index[child] == details::NO_RECORD){
+					index[child] = order.size();
+					order.push_back(child);
+					depth.push_back(depth[i] + 1);
+				}
+			}
+		}
+
+		const std::string temp = path + ".tmp";
+		std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+		if(!out){
+			throw std::runtime_error("can't write snapshot " + temp);
+		}
+		details::snapshot_header head = {};
+		std::memcpy(head.magic, details::SNAPSHOT_MAGIC, sizeof(head.magic));
+		head.version = SNAPSHOT_VERSION;
+		head.stateBytes = sizeof(State);
+		head.scoreBytes = sizeof(Score);
+		head.choiceBytes = sizeof(Choice);
+		head.count = order.size();
+		details::put(out, head);
+		typename Minimax::heuristic_type heuristic;
+		for(std::size_t i = 0; i < order.size(); ++i){
+			const auto& n = mm.pool[order[i]];
+			details::put(out, n.state);
+			if(depth[i] >= maxDepth && n.children.size()){ // cut here, what a height of 0 means
+				details::put(out, heuristic(n.state));
+				details::put(out, std::uint64_t(0));
+				details::put(out, std::uint32_t(0));
+				continue;
+			}
+			std::size_t height = n.height;
+			if(maxDepth != std::numeric_limits<std::size_t>::max()){
+				height = std::min(height, maxDepth - depth[i]);
+			}
+			details::put(out, n.score);
+			details::put(out, std::uint64_t(height));
+			details::put(out, std::uint32_t(n.children.size()));
+			for(std::size_t c = 0; c < n.children.size(); ++c){
+				details::put(out, n.choices[c]);
+				details::put(out, index[n.children[c]]);
+			}
+		}
+		out.close();
+		if(!out || std::rename(temp.c_str(), path.c_str()) != 0){
+			std::remove(temp.c_str());
+			throw std::runtime_error("can't write snapshot " + path);
+		}
+	}
+
+	/**
+	 * Maps the snapshot at path and rebuilds its tree below mm's root. mm must not have searched yet and its
+	 * root must hold the snapshot's root state. Returns false, leaving mm as it was, if the file is missing,
+	 * from another version or build, or for another position. A record with more children than
+	 * GetChoices::MAX_CHOICES ends the file as a cut would, one with a child not written after it is a leaf.
+	 */
+	template<typename Minimax>
+	bool load_snapshot(Minimax& mm, const std::string& path) {
+		using State = typename Minimax::state_type;
+		using Score = typename Minimax::score_type;
+		using Choice = typename Minimax::choice_type;
+		static_assert(std::is_trivially_copyable<State>::value && std::is_trivially_copyable<Score>::value && std::is_trivially_copyable<Choice>::value,
+			"snapshots read State, Score and Choice as bytes");
+		struct record {
+			State state;
+			Score score;
+			std::uint64_t height;
+			std::vector<std::pair<Choice, std::uint32_t>> children;
+		};
+
+		mm.stop_pondering();
+		if(mm.pool[mm.root].children.size()){
+			return false;
+		}
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if(fd < 0){
+			return false;
+		}
+		struct stat info;
+		if(fstat(fd, &info) != 0 || std::size_t(info.st_size) < sizeof(details::snapshot_header)){
+			::close(fd);
+			return false;
+		}
+		void* map = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd); // the mapping keeps the file open
+		if(map == MAP_FAILED){
+			return false;
+		}
+		const char* at = static_cast<const char*>(map);
+		const char* end = at + info.st_size;
+		details::snapshot_header head;
+		details::take(at, end, head);
+		std::vector<record> records;
+		if(
+			std::memcmp(head.magic, details::SNAPSHOT_MAGIC, sizeof(head.magic)) == 0 && head.version == SNAPSHOT_VERSION &&
+			head.stateBytes == sizeof(State) && head.scoreBytes == sizeof(Score) && head.choiceBytes == sizeof(Choice)
+		){
+			while(records.size() < head.count){ // a record cut short ends the file
+				record r;
+				std::uint32_t count;
+				if(!details::take(at, end, r.state) || !details::take(at, end, r.score) || !details::take(at, end, r.height) || !details::take(at, end, count)){
+					break;
+				}
+				if(std::size_t(end - at) / (sizeof(Choice) + sizeof(std::uint32_t)) < count){
+					break;
+				}
+				if(details::max_choices<typename Minimax::choices_type>::value && count > details::max_choices<typename Minimax::choices_type>::value){
+					break; // more children than a node holds, the file is corrupt from here on
+				}
+				r.children.resize(count);
+				for(auto& child : r.children){
+					details::take(at, end, child.first);
+					details::take(at, end, child.second);
+				}
+				records.push_back(std::move(r));
+			}
+		}
+		munmap(map, info.st_size);
+		if(records.empty() || !(records.front().state == mm.pool[mm.root].state)){
+			return false;
+		}
+
+		// children past the cut, or out of range in a corrupt file, turn their parent into a leaf. Children are written
+		// after their parents, one at or before its parent would close a cycle the reference counts never free
+		const std::uint32_t count = records.size();
+		typename Minimax::heuristic_type heuristic;
+		std::vector<bool> cut(count, false);
+		for(std::uint32_t i = 0; i < count; ++i){
+			record& r = records[i];
+			for(auto& child : r.children){
+				if(child.second >= count || child.second <= i){
+					r.children.clear();
+					r.score = heuristic(r.state);
+					r.height = 0;
+					cut[i] = true;
+					break;
+				}
+			}
+		}
+		// only what the root still reaches is rebuilt, parents get their type from the first path to them
+		std::vector<handle> handles(count, null_handle);
+		std::vector<bool> types(count, mm.type());
+		std::vector<std::uint32_t> order = {0};
+		handles[0] = mm.root;
+		for(std::size_t i = 0; i < order.size(); ++i){
+			for(auto& child : records[order[i]].children){
+				if(handles[child.second] == null_handle){
+					types[child.second] = !types[order[i]];
+					handles[child.second] = mm.pool.allocate(mm, records[child.second].state, types[child.second]);
+					order.push_back(child.second);
+				}
+			}
+		}
+		// a cut lowers the heights above it, a parent has searched no further than one past its shallowest leaf
+		for(bool changed = true; changed;){
+			changed = false;
+			for(std::size_t i = order.size(); i-- > 0;){
+				record& r = records[order[i]];
+				for(auto& child : r.children){
+					std::uint64_t height = records[child.second].height;
+					if(height != std::numeric_limits<std::uint64_t>::max() && height + 1 < r.height && cut[child.second]){
+						r.height = height + 1;
+						cut[order[i]] = true;
+						changed = true;
+					}
+				}
+			}
+		}
+		for(std::uint32_t i : order){
+			record& r = records[i];
+			auto& n = mm.pool[handles[i]];
+			n.score = r.score;
+			n.height = r.height == std::numeric_limits<std::uint64_t>::max() ? std::numeric_limits<std::size_t>::max() : std::size_t(r.height);
+			n.children.reserve(r.children.size());
+			n.choices.reserve(r.children.size());
+			for(auto& child : r.children){
+				n.choices.push_back(child.first);
+				n.children.push_back(handles[child.second]);
+				++mm.pool[handles[child.second]].refs;
+			}
+			if(i){
+				bool mirrored;
+				mm.table.link(details::canonical_hash<typename Minimax::choices_type>(r.state, mirrored), handles[i]);
+			}
+		}
+		return true;
+	}
+} }
+
+#endif /* SNAPSHOT_H_ */
@@ -0,0 +1,211 @@
+/*
+ * Solver.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <cstdlib>
+#include <limits>
+#include "Solver.h"
+#include "Connect4.h"
+
+using namespace std;
+
+namespace {
+	constexpr int WIDTH = geometry::WIDTH, HEIGHT = geometry::HEIGHT, H1 = HEIGHT + 1, CELLS = WIDTH * HEIGHT;
+	static_assert(geometry::RUN == 4 && WIDTH * H1 <= 64, "winning_cells finds lines of 4 on a board with a spare row");
+	constexpr int MIN_SCORE = -CELLS / 2 + 3; // the fastest loss once neither side can win on its next move
+	constexpr auto ORDER = geometry::CENTRE_FIRST; // like get_choices
+	constexpr uint64_t MIX = 0x9e3779b97f4a7c15; // golden ratio multiplier, the top bits of key * MIX index the table
+
+	constexpr uint64_t bottom_row(int width){
+		return width ? bottom_row(width - 1) | uint64_t(1) << (width - 1) * H1 : 0;
+	}
+	constexpr uint64_t BOTTOM = bottom_row(WIDTH);
+	constexpr uint64_t BOARD = BOTTOM * ((uint64_t(1) << HEIGHT) - 1);
+
+	constexpr uint64_t column(int col){
+		return ((uint64_t(1) << HEIGHT) - 1) << col * H1;
+	}
+
+	/* bit row*7 + col of board moved to col*H1 + row */
+	uint64_t transpose(uint64_t board) noexcept {
+		uint64_t columns = 0;
+		for(int row = 0; row < HEIGHT; ++row){
+			for(int col = 0; col < WIDTH; ++col){
+				columns |= (board >> (row * WIDTH + col) & 1) << (col * H1 + row);
+			}
+		}
+		return columns;
+	}
+
+	/* the lowest empty cell of every column that has one */
+	uint64_t playable(uint64_t mask) noexcept {
+		return (mask + BOTTOM) & BOARD;
+	}
+
+	/* empty cells that would complete a line of position's discs */
+	uint64_t winning_cells(uint64_t position, uint64_t mask) noexcept {
+		uint64_t cells = (position << 1) & (position << 2) & (position << 3); // vertical, only upwards
+		for(int shift : {H1, H1 - 1, H1 + 1}){ // horizontal and both diagonals
+			uint64_t pair = (position << shift) & (position << 2 * shift);
+			cells |= pair & (position << 3 * shift);
+			cells |= pair & (position >> shift);
+			pair = (position >> shift) & (position >> 2 * shift);
+			cells |= pair & (position << shift);
+			cells |= pair & (position >> 3 * shift);
+		}
+		return cells & (BOARD ^ mask);
+	}
+
+	/* moves that don't hand the opponent a win next turn, 0 if there are none */
+	uint64_t non_losing(uint64_t current, uint64_t mask) noexcept {
+		uint64_t moves = playable(mask);
+		uint64_t threats = winning_cells(current ^ mask, mask);
+		uint64_t forced = moves & threats;
+		if(forced){
+			if(forced & (forced - 1)){ // two threats, only one can be blocked
+				return 0;
+			}
+			moves = forced;
+		}
+		return moves & ~(threats >> 1); // never fill the cell under a threat
+	}
+}
+
+solver::solver(size_t tableBytes) : shift_(64), nodes_(0) {
+	size_t entries = 1;
+	while(entries * 2 * sizeof(uint64_t) <= tableBytes){
+		entries *= 2;
+		--shift_;
+	}
+	table_.assign(entries, 0);
+}
+
+void solver::clear() noexcept {
+	fill(table_.begin(), table_.end(), 0);
+}
+
+int solver::negamax(uint64_t current, uint64_t mask, int moves, int alpha, int beta){
+	++nodes_;
+	uint64_t next = non_losing(current, mask);
+	if(!next){
+		return -(CELLS - moves) / 2;
+	}
+	if(moves >= CELLS - 2){ // the last two discs can't make a line the caller hasn't already seen
+		return 0;
+	}
+	int min = -(CELLS - 2 - moves) / 2; // the opponent can't win on its next move
+	if(alpha < min){
+		alpha = min;
+		if(alpha >= beta){
+			return alpha;
+		}
+	}
+	int max = (CELLS - 1 - moves) / 2; // nor can we
+	const uint64_t key = current + mask; // unique, the mask's carry marks the top of every column
+	uint64_t& entry = table_[(key * MIX) >> shift_];
+	if(entry >> 8 == key){
+		max = int(entry & 0xff) + MIN_SCORE - 1;
+	}
+	if(beta > max){
+		beta = max;
+		if(alpha >= beta){
+			return beta;
+		}
+	}
+
+	// moves that open the most lines first, ORDER breaks ties
+	uint64_t ordered[WIDTH];
+	int threats[WIDTH];
+	int count = 0;
+	for(int col : ORDER){
+		uint64_t move = next & column(col);
+		if(!move){
+			continue;
+		}
+		int opened = bit_count(winning_cells(current | move, mask));
+		int at = count++;
+		for(; at && threats[at - 1] < opened; --at){
+			ordered[at] = ordered[at - 1];
+			threats[at] = threats[at - 1];
+		}
+		ordered[at] = move;
+		threats[at] = opened;
+	}
+	for(int i = 0; i < count; ++i){
+		int score = -negamax(current ^ mask, mask | ordered[i], moves + 1, -beta, -alpha);
+		if(score >= beta){
+			return score;
+		}
+		if(score > alpha){
+			alpha = score;
+		}
+	}
+	entry = key << 8 | uint64_t(alpha - MIN_SCORE + 1);
+	return alpha;
+}
+
+int solver::solve(uint64_t current, uint64_t mask, int moves){
+	if(winning_cells(current, mask) & playable(mask)){
+		return (CELLS + 1 - moves) / 2;
+	}
+	int min = -(CELLS - moves) / 2, max = (CELLS + 1 - moves) / 2;
+	while(min < max){ // null window searches narrow the score, probing near 0 first where most positions end
+		int med = min + (max - min) / 2;
+		if(med <= 0 && min / 2 < med){
+			med = min / 2;
+		} else if(med >= 0 && max / 2 > med){
+			med = max / 2;
+		}
+		int r = negamax(current, mask, moves, med, med + 1);
+		if(r <= med){
+			max = r;
+		} else {
+			min = r;
+		}
+	}
+	return min;
+}
+
+int solver::solve(const state& s){
+	uint64_t mask = transpose(s.players[0] | s.players[1]);
+	return solve(transpose(s.players[s.turn]), mask, bit_count(mask));
+}
+
+int solver::score(const state& s){
+	int value = solve(s);
+	if(value == 0){
+		return 0;
+	}
+	bool winner = value > 0 ? s.turn : !s.turn;
+	int discs = (CELLS + 2) / 2 - abs(value); // the winner's discs once it has won
+	return winner ? 100 * discs - infinity : infinity - (discs - 1);
+}
+
+bool solver::lookup(const state& s, int& choice){
+	uint64_t mask = transpose(s.players[0] | s.players[1]);
+	int moves = bit_count(mask);
+	if(s.end || size_t(moves) < THRESHOLD || moves == CELLS){
+		return false;
+	}
+	uint64_t current = transpose(s.players[s.turn]);
+	uint64_t wins = winning_cells(current, mask) & playable(mask);
+	int best = numeric_limits<int>::min();
+	for(int col : ORDER){
+		uint64_t move = playable(mask) & column(col);
+		if(!move){
+			continue;
+		}
+		if(wins & move){
+			choice = col;
+			return true;
+		}
+		int value = moves + 1 == CELLS ? 0 : -solve(current ^ mask, mask | move, moves + 1);
+		if(value > best){
+			best = value;
+			choice = col;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,66 @@
+/*
+ * Solver.h
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef SOLVER_H_
+#define SOLVER_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "Board.h"
+
+template<typename Board>
+struct basic_state;
+using state = basic_state<geometry>; // the standard board's
+
+/**
+ * Solves positions exactly with a null window negamax, no tree is built and the only memory is a small table
+ * of upper bounds. Searches run on a copy of the board laid out a column at a time with an empty cell above
+ * every column, so a single shift finds every line in a direction without wrapping into the next row.
+ * Scores are for the side to move: 22 less the discs the winner has when it completes a line, negated when
+ * the other side wins, and 0 for a draw, so faster wins score higher.
+ */
+class solver {
+public:
+	static constexpr std::size_t THRESHOLD = 18; // discs on the board from which lookup solves rather than leaving it to the search
+	static constexpr std::size_t DEFAULT_BYTES = std::size_t(8) << 20;
+
+	explicit solver(std::size_t tableBytes = DEFAULT_BYTES);
+
+	/**
+	 * the exact score of s, which must not already be won
+	 */
+	int solve(const state& s);
+
+	/**
+	 * the exact score of s for players[0] on the heuristic's scale: infinity less players[1]'s discs when players[0]
+	 * wins, players[0]'s discs times 100 less infinity when it loses, 0 for a draw
+	 */
+	int score(const state& s);
+
+	/**
+	 * once s has THRESHOLD discs and is still being played, sets choice to the move that ends the game soonest
+	 * if it can be won, latest if it is lost, and returns true
+	 */
+	bool lookup(const state& s, int& choice);
+
+	/**
+	 * positions searched since the solver was made
+	 */
+	std::size_t nodes() const noexcept {
+		return nodes_;
+	}
+	void clear() noexcept;
+private:
+	int solve(uint64_t current, uint64_t mask, int moves);
+	int negamax(uint64_t current, uint64_t mask, int moves, int alpha, int beta);
+
+	std::vector<uint64_t> table_; // current + mask above 8 bits of bound, 0 when empty
+	unsigned shift_;
+	std::size_t nodes_;
+};
+
+#endif /* SOLVER_H_ */
@@ -0,0 +1,59 @@
+/*
+ * Stats.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef STATS_H_
+#define STATS_H_
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+
+namespace dhlib { namespace minimax {
+
+	/**
+	 * What one call to compute, compute_for or ponder did. Tree searches count everything, table searches
+	 * count positions visited as expanded, leaves as evaluated and leave created and transpositions at 0.
+	 */
+	struct search_stats {
+		std::size_t created = 0; // tree nodes allocated while expanding
+		std::size_t expanded = 0; // positions whose choices were generated
+		std::size_t evaluated = 0; // heuristic calls
+		std::size_t transpositions = 0; // children found in the table instead of being created
+		std::size_t cutoffs = 0; // nodes whose remaining children were pruned
+		std::size_t fail_lows = 0; // root searches repeated after scoring at or below their aspiration window
+		std::size_t fail_highs = 0; // and at or above it
+		std::size_t live = 0; // tree nodes after the call
+		std::size_t depth = 0; // the root's height afterwards, or the deepest search that finished if the root is solved
+		std::chrono::nanoseconds elapsed = std::chrono::nanoseconds(0);
+
+		std::size_t nodes() const noexcept {
+			return expanded + evaluated;
+		}
+		/* the branching factor a full tree of depth with as many nodes would have */
+		double branching() const noexcept {
+			return depth && nodes() ? std::pow(double(nodes()), 1.0 / depth) : 0;
+		}
+		/* cutoffs per expansion, tree searches revisit nodes they expanded before so theirs can pass 1 */
+		double cutoff_rate() const noexcept {
+			return expanded ? double(cutoffs) / expanded : 0;
+		}
+		double nps() const noexcept {
+			return elapsed.count() ? nodes() * 1e9 / elapsed.count() : 0;
+		}
+	};
+
+	/**
+	 * Stats policies for minimax, with no_stats every counter compiles away and the hook is never called.
+	 */
+	struct no_stats {
+		static constexpr bool enabled = false;
+	};
+	struct collect_stats {
+		static constexpr bool enabled = true;
+	};
+} }
+
+#endif /* STATS_H_ */
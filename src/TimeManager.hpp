@@ -0,0 +1,58 @@
+/*
+ * TimeManager.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef TIMEMANAGER_H_
+#define TIMEMANAGER_H_
+
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+
+namespace dhlib { namespace minimax {
+
+	/**
+	 * Splits a time bank into per move budgets. The bank starts at timebank, is refilled by increment every move
+	 * and never grows past timebank, so time saved early is only worth keeping up to the cap.
+	 */
+	class time_manager {
+	public:
+		using milliseconds = std::chrono::milliseconds;
+
+		/**
+		 * reserve is kept back from every budget to cover input latency and the search's abort granularity
+		 */
+		time_manager(milliseconds timebank, milliseconds increment, milliseconds reserve = milliseconds(50)) noexcept :
+			timebank_(timebank), increment_(increment), reserve_(reserve) { }
+
+		/**
+		 * the time to spend on the next move given what is left in the bank and how many of our moves may remain
+		 */
+		milliseconds budget(milliseconds remaining, std::size_t movesLeft) const noexcept {
+			milliseconds usable = remaining - reserve_;
+			if(usable <= milliseconds(0)){
+				return milliseconds(1);
+			}
+			movesLeft = std::max<std::size_t>(movesLeft, 1);
+			// whatever the next refill would push over the cap is free to spend now
+			milliseconds overflow = std::max(remaining + increment_ - timebank_, milliseconds(0));
+			milliseconds share = usable / movesLeft + increment_;
+			return std::min(usable, std::max(share, overflow));
+		}
+
+		milliseconds timebank() const noexcept {
+			return timebank_;
+		}
+		milliseconds increment() const noexcept {
+			return increment_;
+		}
+	private:
+		milliseconds timebank_;
+		milliseconds increment_;
+		milliseconds reserve_;
+	};
+} }
+
+#endif /* TIMEMANAGER_H_ */
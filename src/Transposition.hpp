@@ -0,0 +1,244 @@
+/*
+ * Transposition.hpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#ifndef TRANSPOSITION_H_
+#define TRANSPOSITION_H_
+
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <limits>
+#include <cstdint>
+#include <type_traits>
+
+namespace dhlib { namespace minimax {
+
+	using handle = std::uint32_t;
+	constexpr handle null_handle = std::numeric_limits<handle>::max();
+
+	/**
+	 * how a stored score relates to the true score of the position
+	 */
+	enum class bound : std::uint8_t {
+		none = 0, // only the node link is known
+		exact = 1,
+		lower = 2, // the true score is at least the stored score
+		upper = 3 // the true score is at most the stored score
+	};
+
+	/**
+	 * A fixed size, open addressed hash table of search results shared by the tree and the search threads.
+	 * Buckets hold two entries, the first keeps the deepest result of the current search and the second
+	 * is always replaced, an entry pushed out of the first slot moves down to the second. Every entry is
+	 * three words written with relaxed atomics, the first word is the key xor'd with the other two so a
+	 * torn write from a concurrent store reads as a miss instead of as a wrong entry.
+	 * 	Score: an integral type no wider than 32 bits
+	 * 	Choice: an integral type whose values fit in 16 bits
+	 */
+	template<typename Score, typename Choice>
+	class transposition_table {
+	public:
+		static_assert(std::is_integral<Score>::value && sizeof(Score) <= sizeof(std::int32_t), "scores are packed into 32 bits");
+		static_assert(std::is_integral<Choice>::value, "choices are packed into 16 bits");
+
+		static constexpr std::size_t DEFAULT_BYTES = std::size_t(32) << 20;
+		static constexpr std::size_t MAX_DEPTH = 254; // stored depths are clamped to this
+		static constexpr std::size_t SOLVED = std::numeric_limits<std::size_t>::max(); // depth of a fully searched subtree
+
+		struct entry {
+			Score score;
+			bound type;
+			std::size_t depth;
+			bool has_choice;
+			Choice choice;
+			handle node;
+		};
+
+		explicit transposition_table(std::size_t bytes = DEFAULT_BYTES) : slots_(nullptr), shift_(64), generation_(0) {
+			resize(bytes);
+		}
+		transposition_table(const transposition_table&) = delete;
+		transposition_table& operator=(const transposition_table&) = delete;
+
+		/**
+		 * reallocates the table to the largest power of two bucket count that fits in bytes, all entries are lost
+		 */
+		void resize(std::size_t bytes) {
+			std::size_t buckets = 1;
+			while(buckets * 2 * sizeof(bucket) <= bytes){
+				buckets *= 2;
+			}
+			slots_.reset(new bucket[buckets]);
+			shift_ = 64;
+			for(std::size_t b = buckets; b > 1; b >>= 1){
+				--shift_;
+			}
+			buckets_ = buckets;
+			clear();
+		}
+
+		void clear() noexcept {
+			for(std::size_t b = 0; b < buckets_; ++b){
+				for(slot &s : slots_[b].slots){
+					s.check.store(0, std::memory_order_relaxed);
+					s.data.store(0, std::memory_order_relaxed);
+					s.link.store(0, std::memory_order_relaxed);
+				}
+			}
+		}
+
+		/**
+		 * ages every entry, entries from older searches are replaced before deeper ones from this search
+		 */
+		void new_search() noexcept {
+			generation_.store((generation_.load(std::memory_order_relaxed) + 1) & GENERATION_MASK, std::memory_order_relaxed);
+		}
+
+		bool probe(std::uint64_t hash, entry &out) const noexcept {
+			const bucket &b = slots_[index(hash)];
+			for(const slot &s : b.slots){
+				std::uint64_t data = s.data.load(std::memory_order_relaxed);
+				std::uint64_t link = s.link.load(std::memory_order_relaxed);
+				if((s.check.load(std::memory_order_relaxed) ^ data ^ link) == hash && (link & PRESENT)){
+					unpack(data, link, out);
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * stores a search result, keeping the node link of an existing entry for the same position if none is given
+		 */
+		void store(std::uint64_t hash, Score score, bound type, std::size_t depth, const Choice* choice, handle node = null_handle) noexcept {
+			bucket &b = slots_[index(hash)];
+			std::uint64_t generation = generation_.load(std::memory_order_relaxed);
+			slot *target = &b.slots[1];
+			std::uint64_t link = PRESENT | node;
+			for(slot &s : b.slots){
+				std::uint64_t oldData = s.data.load(std::memory_order_relaxed);
+				std::uint64_t oldLink = s.link.load(std::memory_order_relaxed);
+				if((s.check.load(std::memory_order_relaxed) ^ oldData ^ oldLink) == hash && (oldLink & PRESENT)){
+					target = &s;
+					if(node == null_handle){
+						link = oldLink;
+					}
+					break;
+				}
+			}
+			if(target == &b.slots[1]){ // depth preferred slot takes anything at least as deep, or anything when stale
+				slot &preferred = b.slots[0];
+				std::uint64_t oldData = preferred.data.load(std::memory_order_relaxed);
+				std::uint64_t oldLink = preferred.link.load(std::memory_order_relaxed);
+				if(!(oldLink & PRESENT)){
+					target = &preferred;
+				} else if(
+					((oldData >> GENERATION_SHIFT) & GENERATION_MASK) != generation ||
+					packed_depth(depth) >= ((oldData >> DEPTH_SHIFT) & 0xFF)
+				){ // the displaced entry moves down to the always replace slot
+					std::uint64_t oldCheck = preferred.check.load(std::memory_order_relaxed);
+					b.slots[1].check.store(oldCheck, std::memory_order_relaxed);
+					b.slots[1].data.store(oldData, std::memory_order_relaxed);
+					b.slots[1].link.store(oldLink, std::memory_order_relaxed);
+					target = &preferred;
+				}
+			}
+			std::uint64_t data = pack(score, type, depth, choice, generation);
+			target->check.store(hash ^ data ^ link, std::memory_order_relaxed);
+			target->data.store(data, std::memory_order_relaxed);
+			target->link.store(link, std::memory_order_relaxed);
+		}
+
+		/**
+		 * records which tree node holds a position without touching a stored result for it
+		 */
+		void link(std::uint64_t hash, handle node) noexcept {
+			entry existing;
+			if(probe(hash, existing)){
+				store(hash, existing.score, existing.type, existing.depth, existing.has_choice ? &existing.choice : nullptr, node);
+			} else {
+				store(hash, Score(), bound::none, 0, nullptr, node);
+			}
+		}
+
+		std::size_t capacity() const noexcept {
+			return buckets_ * 2;
+		}
+		std::size_t bytes() const noexcept {
+			return buckets_ * sizeof(bucket);
+		}
+
+		/**
+		 * fraction of entries written during the current search, in thousandths, from a sample of the table
+		 */
+		std::size_t permill() const noexcept {
+			std::size_t sample = std::min<std::size_t>(buckets_, 500), used = 0;
+			std::uint64_t generation = generation_.load(std::memory_order_relaxed);
+			for(std::size_t b = 0; b < sample; ++b){
+				for(const slot &s : slots_[b].slots){
+					if((s.link.load(std::memory_order_relaxed) & PRESENT) &&
+						((s.data.load(std::memory_order_relaxed) >> GENERATION_SHIFT) & GENERATION_MASK) == generation){
+						++used;
+					}
+				}
+			}
+			return used * 1000 / (sample * 2);
+		}
+	private:
+		struct slot {
+			std::atomic<std::uint64_t> check;
+			std::atomic<std::uint64_t> data;
+			std::atomic<std::uint64_t> link;
+		};
+		struct bucket {
+			slot slots[2];
+		};
+
+		// data word: score:32 depth:8 bound:2 generation:6 choice:16, choice 0xFFFF means no choice
+		static constexpr unsigned DEPTH_SHIFT = 32;
+		static constexpr unsigned BOUND_SHIFT = 40;
+		static constexpr unsigned GENERATION_SHIFT = 42;
+		static constexpr std::uint64_t GENERATION_MASK = 0x3F;
+		static constexpr unsigned CHOICE_SHIFT = 48;
+		static constexpr std::uint64_t NO_CHOICE = 0xFFFF;
+		// link word: present:1 node:32
+		static constexpr std::uint64_t PRESENT = std::uint64_t(1) << 32;
+
+		static std::uint64_t packed_depth(std::size_t depth) noexcept {
+			return depth == SOLVED ? 0xFF : std::min(depth, MAX_DEPTH);
+		}
+
+		static std::uint64_t pack(Score score, bound type, std::size_t depth, const Choice* choice, std::uint64_t generation) noexcept {
+			return std::uint64_t(std::uint32_t(std::int32_t(score))) |
+				packed_depth(depth) << DEPTH_SHIFT |
+				std::uint64_t(type) << BOUND_SHIFT |
+				generation << GENERATION_SHIFT |
+				(choice ? std::uint64_t(std::uint16_t(*choice)) : NO_CHOICE) << CHOICE_SHIFT;
+		}
+
+		static void unpack(std::uint64_t data, std::uint64_t link, entry &out) noexcept {
+			out.score = Score(std::int32_t(std::uint32_t(data)));
+			std::uint64_t depth = (data >> DEPTH_SHIFT) & 0xFF;
+			out.depth = depth == 0xFF ? SOLVED : depth;
+			out.type = bound((data >> BOUND_SHIFT) & 3);
+			std::uint64_t choice = data >> CHOICE_SHIFT;
+			out.has_choice = choice != NO_CHOICE;
+			out.choice = out.has_choice ? Choice(std::int16_t(choice)) : Choice();
+			out.node = handle(link);
+		}
+
+		std::size_t index(std::uint64_t hash) const noexcept { // fibonacci hashing so weak hashes still spread over the table
+			return shift_ == 64 ? 0 : std::size_t((hash * 0x9E3779B97F4A7C15ull) >> shift_);
+		}
+
+		std::unique_ptr<bucket[]> slots_;
+		std::size_t buckets_;
+		unsigned shift_;
+		std::atomic<std::uint64_t> generation_;
+	};
+} }
+
+#endif /* TRANSPOSITION_H_ */
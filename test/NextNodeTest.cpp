@@ -0,0 +1,91 @@
+/*
+ * NextNodeTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "Minimax.hpp"
+
+using namespace std;
+using namespace dhlib::minimax;
+
+/* a game whose tree the test builds by hand, nothing is ever expanded or scored */
+struct toy {
+	int id;
+};
+bool operator==(const toy& a, const toy& b){
+	return a.id == b.id;
+}
+namespace std {
+	template<>
+	struct hash<const toy> {
+		size_t operator()(const toy& t) const noexcept {
+			return t.id;
+		}
+	};
+}
+struct toy_heuristic {
+	int operator()(const toy&) const noexcept {
+		return 0;
+	}
+};
+struct toy_choices {
+	vector<pair<int,toy>> operator()(const toy&){
+		return {};
+	}
+};
+
+using engine = minimax<int,toy,int,toy_heuristic,toy_choices>;
+
+static bool check(bool ok, const char* what){
+	if(!ok){
+		cerr << "FAILED: " << what << endl;
+	}
+	return ok;
+}
+
+/**
+ * A MIN parent cut off by its first child takes its height from the siblings it skipped, one it never searched
+ * still has the unsearched score and counts at its own height, one it searched counts a ply higher.
+ */
+static bool pruned_parent_height(){
+	constexpr size_t infinity = numeric_limits<size_t>::max();
+	constexpr int highest = numeric_limits<int>::max();
+	engine mm(toy{0}, MAX);
+	handle other = mm.pool.allocate(mm, toy{1}, MIN);
+	handle parent = mm.pool.allocate(mm, toy{2}, MIN);
+	handle cutter = mm.pool.allocate(mm, toy{3}, MAX);
+	handle unsearched = mm.pool.allocate(mm, toy{4}, MAX);
+	handle searched = mm.pool.allocate(mm, toy{5}, MAX);
+
+	engine::node& start = mm.pool[mm.root];
+	start.children = {other, parent};
+	start.score = 5; // from other
+	start.height = infinity;
+	engine::node& p = mm.pool[parent];
+	p.children = {cutter, unsearched, searched};
+	p.score = highest;
+	p.height = infinity;
+	mm.pool[cutter].score = 3; // below 5, MAX won't play into parent
+	mm.pool[cutter].height = 0;
+	mm.pool[unsearched].score = highest;
+	mm.pool[unsearched].height = 4;
+	mm.pool[searched].score = 8;
+	mm.pool[searched].height = 0;
+
+	vector<engine::child_iter> path = {start.children.begin() + 1, p.children.begin()};
+	bool nodeType = MAX;
+	next_node(3, start, highest, path, nodeType, mm.pool, [](engine::node&, size_t, size_t, bool){ });
+	return check(p.height == 1, "a pruned parent's height is one past its searched siblings") &
+		check(start.height == 2, "the cutoff caps the start node's height two past the child that caused it");
+}
+
+int main(){
+	bool ok = pruned_parent_height();
+	cout << (ok ? "passed" : "failed") << endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/*
+ * SnapshotTest.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#include "Connect4.h"
+#include "Snapshot.hpp"
+
+using namespace std;
+using namespace dhlib::minimax;
+
+using engine = minimax<score,state,choice,heuristic,get_choices>;
+
+namespace {
+	struct record {
+		state s;
+		vector<pair<choice, uint32_t>> children; // choice and record index
+	};
+
+	/* writes records as a snapshot the way save_snapshot lays one out, with every node a leaf of height 0 */
+	void write(const string& path, const vector<record>& records){
+		ofstream out(path, ios::binary | ios::trunc);
+		details::snapshot_header head = {};
+		for(size_t i = 0; i < sizeof(head.magic); ++i){
+			head.magic[i] = details::SNAPSHOT_MAGIC[i];
+		}
+		head.version = SNAPSHOT_VERSION;
+		head.stateBytes = sizeof(state);
+		head.scoreBytes = sizeof(score);
+		head.choiceBytes = sizeof(choice);
+		head.count = records.size();
+		details::put(out, head);
+		for(const record& r : records){
+			details::put(out, r.s);
+			details::put(out, heuristic()(r.s));
+			details::put(out, uint64_t(r.children.empty() ? 0 : 1));
+			details::put(out, uint32_t(r.children.size()));
+			for(auto& child : r.children){
+				details::put(out, child.first);
+				details::put(out, child.second);
+			}
+		}
+	}
+
+	state child_of(const state& s, choice c){
+		state child;
+		get_choices::play(s, c, child);
+		return child;
+	}
+
+	bool check(bool ok, const char* what){
+		if(!ok){
+			cerr << "FAILED: " << what << endl;
+		}
+		return ok;
+	}
+
+	const string path = "snapshot_test." + to_string(getpid());
+
+	/* a record with more children than a node holds is dropped, so the root that points to it is a leaf */
+	bool too_many_children(){
+		const state start(0, false, 0, 0);
+		const state first = child_of(start, 3);
+		vector<record> records = {{start, {{3, 1}}}, {first, {}}};
+		for(choice c = 0; c < 9; ++c){
+			records[1].children.emplace_back(c % geometry::WIDTH, records.size());
+			records.push_back({child_of(first, c % geometry::WIDTH), {}});
+		}
+		write(path, records);
+		engine mm(start, MAX);
+		bool loaded = load_snapshot(mm, path);
+		const engine::node& root = mm.pool[mm.root];
+		return check(loaded, "a snapshot with a corrupt record still loads") &
+			check(root.children.empty() && root.choices.empty(), "the root of a record with too many children is a leaf") &
+			check(mm.pool.size() == 1, "nothing past the corrupt record is allocated");
+	}
+
+	/* a child that refers back to its parent, or one written before it, makes its parent a leaf */
+	bool back_reference(){
+		const state start(0, false, 0, 0);
+		const state first = child_of(start, 3);
+		bool ok = true;
+		for(uint32_t target : {0u, 1u}){
+			write(path, {{start, {{3, 1}}}, {first, {{3, target}}}});
+			engine mm(start, MAX);
+			bool loaded = load_snapshot(mm, path);
+			const engine::node& root = mm.pool[mm.root];
+			ok &= check(loaded, "a snapshot with a back reference still loads") &
+				check(root.children.size() == 1 && root.refs == 1, "nothing links back to the root") &&
+				check(mm.pool[root.children.front()].children.empty(), "the record with the back reference is a leaf") &
+				check(mm.pool[root.children.front()].refs == 1, "the child is only held by the root");
+		}
+		return ok;
+	}
+}
+
+int main(){
+	bool ok = too_many_children();
+	ok &= back_reference();
+	unlink(path.c_str());
+	cout << (ok ? "passed" : "failed") << endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+/*
+ * BookBuilder.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+#include "Connect4.h"
+#include "Book.h"
+
+using namespace std;
+using namespace dhlib::minimax;
+
+/**
+ * Searches every position reachable in at most plies moves to depth and writes the best choice of each as a book.
+ * Positions are reached by every legal move, not only the ones get_choices would search, so the book still has the
+ * position after an opponent's reply the engine prunes as a blunder, only the stored choice comes from the search.
+ * usage: BookBuilder <book file> [plies] [depth] [threads]
+ */
+int main(int argc, char* argv[]){
+	if(argc < 2){
+		cerr << "usage: BookBuilder <book file> [plies] [depth] [threads]" << endl;
+		return 1;
+	}
+	const string path = argv[1];
+	const size_t plies = argc > 2 ? stoul(argv[2]) : 4;
+	const size_t depth = argc > 3 ? stoul(argv[3]) : 12;
+	const unsigned threads = argc > 4 ? stoul(argv[4]) : 1;
+	get_choices::randomize = false; // the book only depends on plies and depth
+
+	// breadth first so every position is searched once however many move orders reach it
+	vector<state> level = {state(0,false,0,0)}, positions;
+	unordered_set<uint64_t> seen = {book::key(level.front())};
+	for(size_t ply = 0; ply <= plies && level.size(); ++ply){
+		vector<state> next;
+		for(const state& s : level){
+			positions.push_back(s);
+			if(ply == plies){
+				continue;
+			}
+			for(choice c = 0; c < geometry::WIDTH; ++c){
+				state child;
+				if(get_choices::play(s, c, child) && !child.end && seen.insert(book::key(child)).second){
+					next.push_back(child);
+				}
+			}
+		}
+		level.swap(next);
+	}
+	cerr << positions.size() << " positions up to " << plies << " plies" << endl;
+
+	vector<book::record> records;
+	records.reserve(positions.size());
+	for(size_t i = 0; i < positions.size(); ++i){
+		const state& s = positions[i];
+		minimax<score,state,choice,heuristic,get_choices> mm(s, !s.turn, size_t(8) << 20);
+		mm.algorithm(search_algorithm::pvs);
+		mm.threads(threads);
+		mm.compute(depth);
+		book::record r = {};
+		r.key = book::key(s);
+		r.score = mm.score();
+		r.choice = mm.choose(0);
+		r.depth = mm.pool[mm.root].height == numeric_limits<size_t>::max() ? 255 : depth;
+		records.push_back(r);
+		if((i + 1) % 100 == 0){
+			cerr << i + 1 << '/' << positions.size() << endl;
+		}
+	}
+	book::write(path, records);
+	cerr << "wrote " << records.size() << " positions to " << path << endl;
+}
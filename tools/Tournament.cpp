@@ -0,0 +1,176 @@
+/*
+ * Tournament.cpp
+ *
+ *  Created on: Oct 16, 2026
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Connect4.h"
+
+using namespace std;
+using namespace dhlib::minimax;
+using namespace std::chrono;
+
+using engine = minimax<score,state,choice,heuristic,get_choices>;
+
+/* how one side searches: d<plies> or t<milliseconds per move>, optionally followed by ,<algorithm> */
+struct side {
+	string name;
+	bool timed = false;
+	size_t amount = 6;
+	search_algorithm algorithm = search_algorithm::tree;
+};
+
+static side parse_side(const string& spec){
+	const vector<pair<string, search_algorithm>> algorithms = {
+		{"tree", search_algorithm::tree},
+		{"alphabeta", search_algorithm::alphabeta},
+		{"pvs", search_algorithm::pvs},
+		{"mtdf", search_algorithm::mtdf}
+	};
+	side s;
+	s.name = spec;
+	size_t comma = spec.find(',');
+	if(spec.size() < 2 || (spec[0] != 'd' && spec[0] != 't')){
+		throw invalid_argument("bad side: " + spec);
+	}
+	s.timed = spec[0] == 't';
+	s.amount = stoul(spec.substr(1, comma == string::npos ? string::npos : comma - 1));
+	if(comma != string::npos){
+		string name = spec.substr(comma + 1);
+		auto found = find_if(algorithms.begin(), algorithms.end(), [&name](const auto& a){ return a.first == name; });
+		if(found == algorithms.end()){
+			throw invalid_argument("unknown algorithm: " + name);
+		}
+		s.algorithm = found->second;
+	}
+	return s;
+}
+
+/* what a worker saw, merged once every game is played */
+struct tally {
+	size_t wins = 0, draws = 0, losses = 0; // for side a
+	size_t firstWins = 0, firstGames = 0; // side a's games as players[0]
+	vector<double> latency[2]; // milliseconds per move of side a and side b
+
+	void merge(const tally& other){
+		wins += other.wins;
+		draws += other.draws;
+		losses += other.losses;
+		firstWins += other.firstWins;
+		firstGames += other.firstGames;
+		for(int i = 0; i < 2; ++i){
+			latency[i].insert(latency[i].end(), other.latency[i].begin(), other.latency[i].end());
+		}
+	}
+};
+
+/* plays game number index, side a moves first in even games, the game's moves only depend on seed and index */
+static void play(size_t index, const side sides[2], size_t seed, size_t tableBytes, tally& result){
+	get_choices::seed_thread(seed + index);
+	const state start(0,false,0,0);
+	const int first = index % 2; // which side plays players[0]
+	engine a(start, MAX, tableBytes), b(start, MAX, tableBytes);
+	engine* engines[2] = {&a, &b};
+	for(int i = 0; i < 2; ++i){
+		engines[i]->algorithm(sides[i].algorithm);
+	}
+	state s = start;
+	int mover = first;
+	while(!s.end && bit_count(s.players[0] | s.players[1]) < geometry::CELLS){
+		engine& mm = *engines[mover];
+		steady_clock::time_point begin = steady_clock::now();
+		if(sides[mover].timed){
+			mm.compute_for(milliseconds(sides[mover].amount));
+		} else {
+			mm.compute(sides[mover].amount);
+		}
+		choice c = mm.choose(-1);
+		result.latency[mover].push_back(duration<double, milli>(steady_clock::now() - begin).count());
+		s = mm.progress(c);
+		if(!s.end){ // get_choices keeps one of several winning moves at random, the other tree may lack this one
+			engines[!mover]->progress(c);
+		}
+		mover = !mover;
+	}
+	result.firstGames += first == 0;
+	if(!s.end){
+		++result.draws;
+	} else if(mover == 1){ // side a made the last move, which won
+		++result.wins;
+		result.firstWins += first == 0;
+	} else {
+		++result.losses;
+	}
+}
+
+static double percentile(const vector<double>& sorted, double p){
+	if(sorted.empty()){
+		return 0;
+	}
+	return sorted[min(sorted.size() - 1, size_t(p * sorted.size()))];
+}
+
+/**
+ * Plays games between two engine settings on every core and reports side a's wins, draws and losses, the move
+ * latency percentiles of both sides and the games played per second. Sides swap colours every game and each
+ * game seeds its own thread's move randomization, so depth limited tournaments are reproducible.
+ * usage: Tournament [games] [threads] [side a] [side b] [seed], sides like d8 or t50,pvs
+ */
+int main(int argc, char* argv[]){
+	const size_t games = argc > 1 ? stoul(argv[1]) : 100;
+	const unsigned threads = argc > 2 ? stoul(argv[2]) : max(1u, thread::hardware_concurrency());
+	side sides[2];
+	try {
+		sides[0] = parse_side(argc > 3 ? argv[3] : "d6");
+		sides[1] = parse_side(argc > 4 ? argv[4] : "d6");
+	} catch(const exception& e){
+		cerr << e.what() << endl;
+		return 1;
+	}
+	const size_t seed = argc > 5 ? stoull(argv[5]) : 1473376696515541738ull;
+	const size_t tableBytes = size_t(8) << 20; // per engine, two per game in flight
+
+	atomic<size_t> next(0), done(0);
+	tally total;
+	mutex lock;
+	steady_clock::time_point begin = steady_clock::now();
+	vector<thread> workers;
+	for(unsigned t = 0; t < min<size_t>(threads, games); ++t){
+		workers.emplace_back([&](){
+			tally mine;
+			for(size_t index = next++; index < games; index = next++){
+				play(index, sides, seed, tableBytes, mine);
+				size_t finished = ++done;
+				if(finished % 10 == 0){
+					cerr << finished << '/' << games << endl;
+				}
+			}
+			lock_guard<mutex> guard(lock);
+			total.merge(mine);
+		});
+	}
+	for(thread& worker : workers){
+		worker.join();
+	}
+	double seconds = duration<double>(steady_clock::now() - begin).count();
+
+	cout << "a " << sides[0].name << " vs b " << sides[1].name << ": " << games << " games on " << workers.size()
+		<< " threads in " << fixed << setprecision(2) << seconds << " s, " << games / seconds << " games/s" << endl;
+	cout << "a wins " << total.wins << " draws " << total.draws << " losses " << total.losses
+		<< " (wins moving first " << total.firstWins << '/' << total.firstGames << ")" << endl;
+	for(int i = 0; i < 2; ++i){
+		vector<double>& latency = total.latency[i];
+		sort(latency.begin(), latency.end());
+		cout << (i ? "b " : "a ") << latency.size() << " moves, ms p50 " << setprecision(3) << percentile(latency, 0.5)
+			<< " p90 " << percentile(latency, 0.9) << " p99 " << percentile(latency, 0.99)
+			<< " max " << (latency.empty() ? 0 : latency.back()) << endl;
+	}
+}